@@ -0,0 +1,141 @@
+#include <QueryCraft/querycraft.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <new>
+#include <string>
+#include <vector>
+
+/// Данный пример проверяет количество выделений памяти на вызов при добавлении строк и генерации запросов.
+/// Возвращает ненулевой код, если какой-либо вызов выделяет больше памяти, чем ожидается.
+
+namespace {
+
+size_t allocations = 0;
+
+/**
+ * Возвращает количество выделений памяти при вызове функции.
+ */
+template<typename Function>
+size_t count_allocations(Function&& function)
+{
+    const auto before = allocations;
+    function();
+
+    return allocations - before;
+}
+
+bool expect(const char* name, const size_t actual, const size_t expected)
+{
+    std::cout << name << ": " << actual << " allocations (expected " << expected << ")\n";
+
+    return actual <= expected;
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+
+    if(auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    sql_table table("users", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("age"));
+
+    const auto id = table.column("id");
+    const auto name = table.column("name");
+    const auto age = table.column("age");
+
+    const auto condition = (age > 18) && (name == std::string("Ivan"));
+
+    auto ok = true;
+    std::string out;
+    out.reserve(1024);
+
+    // Список столбцов передается без временного вектора, запрос пишется в переиспользуемый буфер
+    ok &= expect("select_sql into buffer",
+        count_allocations([&]() {
+            out.clear();
+            table.select_sql(out, {}, condition, { asc_sort(id) }, 10, 0, { id, name });
+        }),
+        0);
+
+    // Выделяется только строка результата
+    ok &= expect("select_args_sql",
+        count_allocations([&]() {
+            const auto sql = table.select_args_sql({}, condition, {}, 10, 0, { id, name });
+        }),
+        1);
+
+    // Строка перемещается в таблицу
+    sql_table::row row { "1", "Ivan", "30" };
+    table.add_rows(&row, &row + 1);
+    table.insert_sql(out);
+
+    ok &= expect("add_row(row&&)",
+        count_allocations([&]() {
+            table.add_row(std::move(row));
+        }),
+        0);
+
+    table.insert_sql(out);
+
+    // Значения преобразуются сразу в строку таблицы: выделяется только вектор строки и память самого преобразования
+    const auto conversions = count_allocations([&]() {
+        const auto converted = type_converter_api::type_converter<int>().convert_to_string(2)
+            + type_converter_api::type_converter<const char*>().convert_to_string("Petr")
+            + type_converter_api::type_converter<int>().convert_to_string(40);
+    });
+
+    ok &= expect("emplace_row",
+        count_allocations([&]() {
+            table.emplace_row(2, "Petr", 40);
+        }),
+        1 + conversions);
+
+    // Память под все строки диапазона резервируется заранее
+    std::vector<sql_table::row> rows(100, sql_table::row { "3", "Anna", "25" });
+
+    table.insert_sql(out);
+    ok &= expect("add_rows(move_iterator) x100",
+        count_allocations([&]() {
+            table.add_rows(std::make_move_iterator(rows.begin()), std::make_move_iterator(rows.end()));
+        }),
+        1);
+
+    // Запрос вставки в переиспользуемый буфер
+    out.clear();
+    out.reserve(8192);
+    ok &= expect("insert_sql into buffer",
+        count_allocations([&]() {
+            table.insert_sql(out, { id, name, age });
+        }),
+        0);
+
+    std::cout << (ok ? "OK" : "FAILED") << "\n";
+
+    return ok ? 0 : 1;
+}
\ No newline at end of file
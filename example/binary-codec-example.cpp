@@ -0,0 +1,157 @@
+#include <QueryCraft/querycraft.h>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/// Данный пример демонстрирует передачу условий и описаний выборки в двоичном виде.
+/// Пример проверяет на случайных деревьях, что восстановленное условие генерирует тот же SQL,
+/// что усеченные и искаженные данные отклоняются только через std::invalid_argument, и сравнивает скорость с unwrap()
+
+namespace {
+
+query_craft::condition_group random_condition(const query_craft::sql_table& table, std::mt19937& generator, const int depth)
+{
+    using namespace query_craft;
+
+    std::uniform_int_distribution<int> choice(0, 9);
+    const auto column = table.column(choice(generator) % 3);
+    const auto value = std::to_string(choice(generator)) + (choice(generator) < 2 ? "'quote" : "");
+
+    if(depth > 0 && choice(generator) < 6) {
+        const auto left = random_condition(table, generator, depth - 1);
+        const auto right = random_condition(table, generator, depth - 1);
+
+        return choice(generator) < 5 ? left && right : left || right;
+    }
+
+    switch(choice(generator)) {
+        case 0:
+            return column == value;
+        case 1:
+            return column != value;
+        case 2:
+            return column < value;
+        case 3:
+            return column >= value;
+        case 4:
+            return column.in(value, std::string("x"), std::string("y"));
+        case 5:
+            return column.like(value + "%");
+        case 6:
+            return column.is_null();
+        case 7:
+            return column.not_null();
+        case 8:
+            return column.equals(table.column("c1"));
+        default:
+            return exists(table.sub_select({}, table.column("c2") == value));
+    }
+}
+
+} // namespace
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("c1", primary_key()),
+        column_info("c2"),
+        column_info("c3"));
+
+    std::mt19937 generator(42);
+
+    // Проверка decode(encode(x)) на случайных деревьях
+    for(int i = 0; i < 10000; i++) {
+        const auto condition = random_condition(table, generator, 6);
+        const auto decoded = codec::decode_condition(codec::encode(condition));
+
+        if(decoded.unwrap(condion_view_type::full_name) != condition.unwrap(condion_view_type::full_name)) {
+            std::cout << "mismatch: " << condition.unwrap(condion_view_type::full_name) << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << "round trip: OK\n";
+
+    // Усеченные данные никогда не являются корректным условием
+    const auto sample = codec::encode(random_condition(table, generator, 6));
+
+    for(size_t size = 0; size < sample.size(); size++) {
+        try {
+            codec::decode_condition(sample.data(), size);
+            std::cout << "truncated to " << size << " bytes: decoded\n";
+            return 1;
+        } catch(const std::invalid_argument&) {
+        }
+    }
+
+    std::cout << "truncated: OK\n";
+
+    // Искаженные данные либо декодируются, либо отклоняются, но другие исключения и падения недопустимы
+    int rejected = 0;
+
+    for(int i = 0; i < 10000; i++) {
+        auto data = codec::encode(random_condition(table, generator, 4));
+        std::uniform_int_distribution<size_t> position(0, data.size() - 1);
+        std::uniform_int_distribution<int> byte(0, 255);
+
+        for(int j = 0; j < 1 + i % 4; j++)
+            data[position(generator)] = static_cast<char>(byte(generator));
+
+        try {
+            codec::decode_condition(data).unwrap(condion_view_type::full_name);
+        } catch(const std::invalid_argument&) {
+            rejected++;
+        }
+    }
+
+    std::cout << "mutated: OK, rejected " << rejected << " of 10000\n";
+
+    // Описание выборки строится в одном процессе, а SQL генерируется в другом
+    select_description description;
+    description.source = table;
+    description.joins = { { join_column::type::left, table, table.column("c1").not_null() } };
+    description.condition = table.column("c2") > 5 && table.column("c3").like("abc%");
+    description.sorts = { desc_sort(table.column("c2")) };
+    description.limit = 10;
+    description.columns = { table.column("c1"), table.column("c2") };
+
+    const auto data = codec::encode(description);
+    const auto restored = codec::decode_select(data);
+
+    std::cout << "bytes: " << data.size() << "\n";
+    std::cout << select_sql(restored) << "\n";
+    std::cout << "select round trip: " << (select_sql(restored) == select_sql(description) ? "OK" : "FAIL") << "\n";
+
+    // Сравнение скорости кодирования со скоростью генерации SQL
+    const auto condition = random_condition(table, generator, 10);
+    std::string buffer;
+
+    constexpr int iterations = 100000;
+
+    auto start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; i++) {
+        buffer.clear();
+        codec::encode(buffer, condition);
+    }
+    const std::chrono::duration<double> encode_time = std::chrono::steady_clock::now() - start;
+    const auto encoded_size = buffer.size();
+
+    start = std::chrono::steady_clock::now();
+    for(int i = 0; i < iterations; i++) {
+        buffer.clear();
+        condition.unwrap(buffer, condion_view_type::full_name);
+    }
+    const std::chrono::duration<double> unwrap_time = std::chrono::steady_clock::now() - start;
+
+    std::cout << "encode: " << encoded_size << " bytes, " << encode_time.count() * 1e9 / iterations << " ns"
+              << "; unwrap: " << buffer.size() << " bytes, " << unwrap_time.count() * 1e9 / iterations << " ns\n";
+
+    return 0;
+}
\ No newline at end of file
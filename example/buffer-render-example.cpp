@@ -0,0 +1,71 @@
+#include <QueryCraft/querycraft.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+/// Данный пример демонстрирует генерацию запросов в переиспользуемый буфер
+/// и подсчитывает количество выделений памяти в установившемся режиме
+
+namespace {
+size_t allocation_count = 0;
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+    allocation_count++;
+
+    if(auto* memory = std::malloc(size == 0 ? 1 : size))
+        return memory;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("c1"),
+        column_info("c2"),
+        column_info("c3"));
+
+    const auto condition = table.column("c1") > 5 && (table.column("c2").is_null() || table.column("c3").in(1, 2, 3));
+    const std::vector<join_column> joins = { { join_column::type::left, static_cast<query_craft::table>(table), table.column("c1").not_null() } };
+    const std::vector<sort_column> sorts = { desc_sort(table.column("c2")) };
+
+    // Буфер переиспользуется между запросами, память выделяется только на первых итерациях
+    std::string buffer;
+
+    for(int i = 0; i < 1000; i++) {
+        if(i == 10)
+            allocation_count = 0;
+
+        buffer.clear();
+        table.select_sql(buffer, joins, condition, sorts, 10, 20);
+
+        buffer.clear();
+        table.remove_sql(buffer, condition);
+    }
+
+    std::cout << buffer << "\n";
+    std::cout << "allocations in steady state: " << allocation_count << "\n";
+
+    // Строковые версии заранее вычисляют точный размер запроса и выделяют память один раз
+    allocation_count = 0;
+    const auto sql = table.select_sql(joins, condition, sorts, 10, 20);
+    std::cout << "allocations per select_sql: " << allocation_count << ", size: " << sql.size() << ", capacity: " << sql.capacity() << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <QueryCraft/querycraft.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Данный пример демонстрирует разделение имен столбцов между копиями.
+/// Столбец хранит только указатель на набор имен, поэтому копии столбцов в условиях и сортировках не дублируют строки,
+/// а набор имен освобождается вместе с последней копией.
+
+int main()
+{
+    using namespace query_craft;
+
+    // Таблица с большим количеством столбцов
+    std::vector<column_info> columns;
+    for(int i = 0; i < 300; i++)
+        columns.emplace_back("column_" + std::to_string(i));
+
+    const sql_table table(query_craft::table("wide_table", "schema_name", columns.begin(), columns.end()));
+
+    // Тысячи условий по столбцам таблицы
+    std::vector<condition_group> conditions;
+    for(int i = 0; i < 10000; i++)
+        conditions.push_back(table.column(i % 300) == std::to_string(i));
+
+    std::cout << "sizeof(column_info): " << sizeof(column_info) << "\n";
+    std::cout << "sizeof(condition_info): " << sizeof(condition_info) << "\n";
+
+    // Столбцы, полученные разными способами, указывают на один набор имен
+    const auto by_index = table.column(7);
+    const auto by_name = table.column("column_7");
+
+    std::cout << "same names: " << (&by_index.full_name() == &by_name.full_name() ? "yes" : "no") << "\n";
+    std::cout << conditions[7].unwrap(condion_view_type::full_name) << "\n";
+
+    // Сравнение столбцов сводится к сравнению указателей
+    constexpr int rounds = 2000;
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t matches = 0;
+    for(int round = 0; round < rounds; round++) {
+        for(const auto& condition : conditions) {
+            if(condition.leaf().condition_column() == by_name)
+                matches++;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "matches: " << matches << ", compare: " << elapsed / (rounds * conditions.size()) << " ns\n";
+
+    return 0;
+}
\ No newline at end of file
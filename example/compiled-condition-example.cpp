@@ -0,0 +1,86 @@
+#include <QueryCraft/querycraft.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Данный пример демонстрирует проверку строк в памяти скомпилированным условием
+/// и замеряет скорость фильтрации в строках в секунду
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("amount"));
+
+    const std::vector<compiled_condition::row> rows = {
+        { "1", "apple", "10" },
+        { "2", "banana", "9" },
+        { "3", "avocado", column_info::null_value() },
+        { "4", "cherry", "100" },
+    };
+
+    // Способ сравнения задается типом столбца: id и amount числовые, name текстовый
+    compiled_condition::settings settings;
+    settings.numeric_columns = { "id", "amount" };
+
+    // "10" и "9" сравниваются как числа, NULL не проходит ни одно сравнение
+    const compiled_condition numeric(table.column("amount") > 9, table, settings);
+    std::cout << "amount > 9: " << numeric.filter(rows).size() << " rows\n";
+
+    // В текстовом столбце те же значения сравниваются побайтово: '10' < '9', как в базе данных
+    const compiled_condition text(table.column("amount") > 9, table);
+    std::cout << "amount > 9 (text column): " << text.filter(rows).size() << " rows\n";
+
+    const compiled_condition like(table.column("name").like("a%") && table.column("amount").is_null(), table);
+    std::cout << "name LIKE 'a%' AND amount IS NULL: " << like.filter(rows).size() << " rows\n";
+
+    // Символ экранирования LIKE задается настройками: в PostgreSQL '\\' экранирует '%', в SQLite без ESCAPE это обычный символ
+    const std::vector<compiled_condition::row> discounts = { { "5", "50%", "1" }, { "6", "50\\%", "1" } };
+    const auto percent = table.column("name").like("50\\%");
+
+    std::cout << "PostgreSQL name LIKE '50\\%': " << compiled_condition(percent, table).filter(discounts).front()[1] << "\n";
+    std::cout << "SQLite name LIKE '50\\%': "
+              << compiled_condition(percent, table, compiled_condition::sqlite_settings()).filter(discounts).front()[1] << "\n";
+
+    // Сравнение с NULL дает неизвестный результат, поэтому строка с NULL не попадает ни в IN, ни в NOT IN
+    const compiled_condition not_in(table.column("id").notIn(1, 2), table, settings);
+    std::cout << "id NOT IN (1, 2): " << not_in.filter(rows).size() << " rows\n";
+
+    // Пользовательская функция доступа к значениям вместо модели строк sql_table
+    const std::vector<std::string> values = { "7", "avocado", "15" };
+    std::cout << "accessor: " << numeric.matches([&values](size_t index) -> const std::string& { return values[index]; }) << "\n";
+
+    // Замер скорости фильтрации
+    std::vector<compiled_condition::row> generated;
+    generated.reserve(1000000);
+    for(size_t i = 0; i < 1000000; i++)
+        generated.push_back({ std::to_string(i), i % 3 == 0 ? "apple" : "banana", std::to_string(i % 1000) });
+
+    const compiled_condition condition(
+        (table.column("amount") >= 100 && table.column("amount") < 500 && table.column("name").like("app%"))
+            || table.column("id").in(1, 2, 3, 4, 5),
+        table,
+        settings);
+
+    const auto start = std::chrono::steady_clock::now();
+
+    size_t matched = 0;
+    for(const auto& row : generated) {
+        if(condition.matches(row))
+            matched++;
+    }
+
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    std::cout << "instructions: " << condition.size()
+              << ", matched: " << matched
+              << ", rows/s: " << static_cast<size_t>(generated.size() / elapsed.count()) << "\n";
+
+    return 0;
+}
\ No newline at end of file
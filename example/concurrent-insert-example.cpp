@@ -0,0 +1,59 @@
+#include <QueryCraft/querycraft.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+/// Данный пример демонстрирует генерацию запросов на вставку из нескольких потоков
+/// с общим неизменяемым описанием таблицы и замеряет масштабирование по числу потоков
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице, описание создается один раз и разделяется между потоками
+    const auto schema = make_shared_schema(sql_table("table_name", "schema_name",
+        column_info("c1"),
+        column_info("c2"),
+        column_info("c3")));
+
+    constexpr int statements_per_thread = 20000;
+    constexpr int rows_per_statement = 10;
+
+    const auto max_threads = std::max(1u, std::thread::hardware_concurrency());
+
+    for(unsigned thread_count = 1; thread_count <= max_threads; thread_count *= 2) {
+        const auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> threads;
+        for(unsigned i = 0; i < thread_count; i++) {
+            threads.emplace_back([&schema, i]() {
+                // У каждого потока собственный буфер строк, блокировки не нужны
+                row_batch batch(schema);
+                size_t total_size = 0;
+
+                for(int statement = 0; statement < statements_per_thread; statement++) {
+                    for(int row = 0; row < rows_per_statement; row++)
+                        batch.add_row_args(statement, i, row);
+
+                    total_size += batch.insert_sql().size();
+                }
+
+                if(total_size == 0)
+                    std::cerr << "Пустой результат\n";
+            });
+        }
+
+        for(auto& thread : threads)
+            thread.join();
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        const auto statements = static_cast<double>(statements_per_thread) * thread_count;
+
+        std::cout << "threads: " << thread_count
+                  << ", statements/s: " << static_cast<size_t>(statements / elapsed.count()) << "\n";
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,33 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует генерацию запросов для проверки существования и подсчета строк
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("c1"),
+        column_info("c2"),
+        column_info("c3"));
+
+    const auto condition = table.column("c1") > 5 && table.column("c2").is_null();
+
+    // Проверка существования строк без выборки столбцов
+    std::cout << table.exists_sql({}, condition) << "\n";
+
+    // Точный подсчет строк
+    std::cout << table.count_sql({}, condition) << "\n";
+
+    // Оценка количества строк по статистике PostgreSQL для всей таблицы и по условию
+    std::cout << table.estimated_count_sql() << "\n";
+    std::cout << table.estimated_count_sql(condition) << "\n";
+
+    // Разбор результата EXPLAIN (FORMAT JSON)
+    std::cout << sql_table::parse_estimated_count(R"([{"Plan": {"Node Type": "Seq Scan", "Plan Rows": 12345}}])") << "\n";
+
+    return 0;
+}
\ No newline at end of file
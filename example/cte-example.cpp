@@ -0,0 +1,38 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует обход дерева категорий одним запросом с помощью WITH RECURSIVE
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице категорий
+    const sql_table categories("categories", "public",
+        column_info("id"),
+        column_info("parent_id"),
+        column_info("name"));
+
+    // Общее табличное выражение описывается таблицей без схемы, на него можно ссылаться как на обычную таблицу
+    const sql_table tree("tree", "",
+        column_info("id"),
+        column_info("parent_id"),
+        column_info("name"));
+
+    const std::vector<column_info> tree_columns = { categories.column("id"), categories.column("parent_id"), categories.column("name") };
+
+    // Начальная категория
+    const auto anchor = categories.sub_select({}, categories.column("id") == 1, {}, 0, 0, tree_columns);
+
+    // Дочерние категории уже найденных
+    const auto children = categories.sub_select(
+        { { join_column::type::inner, static_cast<table>(tree), categories.column("parent_id").equals(tree.column("id")) } },
+        {}, {}, 0, 0, tree_columns);
+
+    std::cout << with_sql({ recursive_cte(tree, anchor, children) },
+        tree.select_sql({}, {}, { asc_sort(tree.column("name")) }))
+              << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует генерацию запросов для чтения большой выборки пачками через серверный курсор
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("c1"),
+        column_info("c2"),
+        column_info("c3"));
+
+    sql_cursor cursor("export_cursor", table.sub_select({}, table.column("c1") > 5));
+
+    // Курсор ограничен транзакцией, которую открывает и фиксирует вызывающая сторона.
+    // Каждая строка - отдельный запрос, пригодный для подготовленных запросов
+    if(cursor.requires_transaction())
+        std::cout << "BEGIN;\n";
+
+    std::cout << cursor.open_sql() << "\n";
+
+    // Каждый запрос возвращает не более 1000 строк. Пачка меньшего размера означает конец результата
+    std::cout << cursor.fetch_sql(1000) << "\n";
+
+    std::cout << cursor.close_sql() << "\n";
+
+    if(cursor.requires_transaction())
+        std::cout << "COMMIT;\n";
+
+    // Кавычки в имени курсора удваиваются
+    const sql_cursor quoted("export\"; DROP TABLE t; --", table.sub_select(), sql_cursor::scope::with_hold);
+    std::cout << quoted.close_sql() << "\n";
+
+    return 0;
+}
\ No newline at end of file
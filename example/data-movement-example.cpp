@@ -0,0 +1,52 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует копирование и перенос строк между таблицами на сервере без передачи данных клиенту.
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблицах
+    const sql_table orders("orders", "public",
+        column_info("id", primary_key()),
+        column_info("user_id"),
+        column_info("total"),
+        column_info("created"));
+
+    const sql_table archive("orders_archive", "public",
+        column_info("id", primary_key()),
+        column_info("user_id"),
+        column_info("total"),
+        column_info("created"));
+
+    const sql_table report("user_totals", "public",
+        column_info("user_id"),
+        column_info("total"),
+        column_info("created"));
+
+    const auto old_orders = orders.column("created") < std::string("2024-01-01");
+
+    // Копирование всех столбцов старых заказов
+    std::cout << archive.insert_from_select_sql({}, orders, {}, old_orders) << "\n\n";
+
+    // Копирование части столбцов с сортировкой и лимитом
+    std::cout << report.insert_from_select_sql({},
+        orders,
+        {},
+        orders.column("total") > 1000,
+        { desc_sort(orders.column("total")) },
+        100,
+        0,
+        { orders.column("user_id"), orders.column("total"), orders.column("created") })
+              << "\n\n";
+
+    // Перенос старых заказов в архив одним запросом
+    std::cout << orders.move_to_sql(archive, old_orders) << "\n\n";
+
+    // Перенос пачками по 10000 строк, чтобы не блокировать таблицу надолго
+    std::cout << orders.move_to_sql(archive, old_orders, {}, {}, 10000) << "\n";
+
+    return 0;
+}
\ No newline at end of file
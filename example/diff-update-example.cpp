@@ -0,0 +1,73 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// Данный пример демонстрирует обновление только измененных столбцов.
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("users", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("email"),
+        column_info("age"));
+
+    const auto id = table.column("id");
+
+    const sql_table::row old_row { "1", "Ivan", "ivan@example.com", "30" };
+    const sql_table::row new_row { "1", "Ivan", "ivan@example.org", "30" };
+
+    // Обновляется только email
+    std::cout << table.diff_update_sql(old_row, new_row, id == 1) << "\n";
+
+    // Проверка IS DISTINCT FROM: запрос не изменяет строку, если значение уже совпадает
+    std::cout << table.diff_update_sql(old_row, { "1", "Ivan", "ivan@example.org", "NULL" }, id == 1, true) << "\n";
+
+    // Без изменений запрос не нужен
+    std::cout << "unchanged: \"" << table.diff_update_sql(old_row, old_row, id == 1) << "\"\n";
+
+    // Изменения, отмеченные маской
+    std::cout << table.masked_update_sql(new_row, { false, true, false, true }, id == 1) << "\n";
+
+    // Пакетное обновление: строки с одинаковыми изменениями объединяются в один запрос
+    const std::vector<std::pair<sql_table::row, sql_table::row>> changes {
+        { { "1", "Ivan", "a@example.com", "30" }, { "1", "Ivan", "a@example.com", "31" } },
+        { { "2", "Petr", "b@example.com", "40" }, { "2", "Petr", "b@example.com", "40" } },
+        { { "3", "Anna", "c@example.com", "25" }, { "3", "Anna", "c@example.com", "31" } },
+        { { "4", "Olga", "d@example.com", "28" }, { "4", "Olga", "new@example.com", "28" } }
+    };
+
+    for(const auto& sql : table.diff_update_batch_sql(changes, id, true))
+        std::cout << sql << "\n";
+
+    // Значения ключа экранируются так же, как присваиваемые значения
+    const sql_table accounts("accounts", "public",
+        column_info("login", primary_key()),
+        column_info("name"),
+        column_info("email"));
+
+    const std::vector<std::pair<sql_table::row, sql_table::row>> quoted {
+        { { "o'neil", "Old", "NULL" }, { "o'neil", "New", "NULL" } },
+        { { "x') OR ('1' = '1", "Old", "NULL" }, { "x') OR ('1' = '1", "New", "NULL" } }
+    };
+
+    const auto quoted_sql = accounts.diff_update_batch_sql(quoted, accounts.column("login"));
+    const std::string expected = "UPDATE \"public\".\"accounts\" SET \"name\" = 'New' WHERE \"login\" IN ('o''neil', 'x'') OR (''1'' = ''1');";
+
+    std::cout << quoted_sql.front() << "\n";
+
+    if(quoted_sql.size() != 1 || quoted_sql.front() != expected) {
+        std::cout << "quoted key: FAIL\n";
+        return 1;
+    }
+
+    std::cout << "quoted key: OK\n";
+
+    return 0;
+}
\ No newline at end of file
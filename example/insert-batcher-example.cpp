@@ -0,0 +1,173 @@
+#include <QueryCraft/querycraft.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+/// Данный пример демонстрирует накопление строк от нескольких потоков с автоматическим сбросом в запросы INSERT.
+/// Пример проверяет, что ни одна строка не потеряна и не продублирована, в том числе при ошибках приемника,
+/// что ожидающих строк не больше max_pending_rows, и замеряет скорость по числу производителей
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const auto schema = make_shared_schema(sql_table("table_name", "schema_name",
+        column_info("id"),
+        column_info("producer"),
+        column_info("payload")));
+
+    constexpr size_t rows_per_producer = 50000;
+
+    for(size_t producer_count = 1; producer_count <= 8; producer_count *= 2) {
+        const auto total_rows = rows_per_producer * producer_count;
+
+        // Вызовы приемника сериализованы, поэтому для проверки достаточно обычного вектора
+        std::vector<int> seen(total_rows, 0);
+        size_t statements = 0;
+
+        insert_batcher::settings settings;
+        settings.max_rows = 500;
+        settings.max_pending_rows = 20000;
+
+        const auto start = std::chrono::steady_clock::now();
+
+        {
+            insert_batcher batcher(schema, [&seen, &statements](const std::string&, const std::vector<insert_batcher::row>& rows) {
+                statements++;
+                for(const auto& row : rows)
+                    seen[std::stoul(row.front())]++;
+            },
+                settings);
+
+            std::vector<std::thread> producers;
+            for(size_t producer = 0; producer < producer_count; producer++) {
+                producers.emplace_back([&batcher, producer]() {
+                    for(size_t i = 0; i < rows_per_producer; i++)
+                        batcher.add_row_args(producer * rows_per_producer + i, producer, "payload");
+                });
+            }
+
+            for(auto& producer : producers)
+                producer.join();
+
+            // Оставшиеся строки сбрасываются при остановке
+            batcher.stop();
+        }
+
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        size_t lost = 0;
+        size_t duplicated = 0;
+        for(const auto count : seen) {
+            if(count == 0)
+                lost++;
+            if(count > 1)
+                duplicated++;
+        }
+
+        std::cout << "producers: " << producer_count
+                  << ", rows/s: " << static_cast<size_t>(total_rows / elapsed.count())
+                  << ", statements: " << statements
+                  << ", lost: " << lost
+                  << ", duplicated: " << duplicated << "\n";
+
+        if(lost != 0 || duplicated != 0)
+            return 1;
+    }
+
+    // Приемник отклоняет каждую третью пачку: отклоненные строки отправляются повторно
+    constexpr size_t producer_count = 4;
+    constexpr size_t total_rows = rows_per_producer * producer_count;
+
+    std::vector<int> seen(total_rows, 0);
+    size_t calls = 0;
+    size_t max_pending = 0;
+    size_t producer_errors = 0;
+    std::mutex errors_mutex;
+
+    insert_batcher::settings settings;
+    settings.max_rows = 500;
+    settings.max_pending_rows = 2000;
+    settings.max_delay = std::chrono::milliseconds(1);
+
+    const insert_batcher* observed = nullptr;
+
+    {
+        insert_batcher batcher(schema, [&](const std::string&, const std::vector<insert_batcher::row>& rows) {
+            max_pending = std::max(max_pending, observed->pending_rows());
+
+            if(++calls % 3 == 0)
+                throw std::runtime_error("connection lost");
+
+            for(const auto& row : rows)
+                seen[std::stoul(row.front())]++;
+        },
+            settings);
+
+        observed = &batcher;
+
+        std::vector<std::thread> producers;
+        for(size_t producer = 0; producer < producer_count; producer++) {
+            producers.emplace_back([&, producer]() {
+                for(size_t i = 0; i < rows_per_producer; i++) {
+                    // Исключение приемника пробрасывается до добавления строки, поэтому строка добавляется повторно
+                    while(true) {
+                        try {
+                            batcher.add_row_args(producer * rows_per_producer + i, producer, "payload");
+                            break;
+                        } catch(const std::runtime_error&) {
+                            std::lock_guard<std::mutex> lock(errors_mutex);
+                            producer_errors++;
+                        }
+                    }
+                }
+            });
+        }
+
+        for(auto& producer : producers)
+            producer.join();
+
+        // Остановка может завершиться ошибкой приемника, тогда оставшиеся строки отправляются повторно
+        bool stopped = false;
+        while(!stopped) {
+            try {
+                batcher.stop();
+                stopped = true;
+            } catch(const std::runtime_error&) {
+            }
+        }
+
+        while(batcher.pending_rows() != 0) {
+            try {
+                batcher.flush();
+            } catch(const std::runtime_error&) {
+            }
+        }
+    }
+
+    size_t lost = 0;
+    size_t duplicated = 0;
+    for(const auto count : seen) {
+        if(count == 0)
+            lost++;
+        if(count > 1)
+            duplicated++;
+    }
+
+    std::cout << "failing sink: calls: " << calls
+              << ", producer errors: " << producer_errors
+              << ", max pending: " << max_pending
+              << ", lost: " << lost
+              << ", duplicated: " << duplicated << "\n";
+
+    if(lost != 0 || duplicated != 0 || max_pending > settings.max_pending_rows)
+        return 1;
+
+    return 0;
+}
\ No newline at end of file
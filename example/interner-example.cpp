@@ -0,0 +1,99 @@
+#include <QueryCraft/querycraft.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Данный пример демонстрирует объединение одинаковых поддеревьев условий.
+/// Фильтры многих запросов содержат общую часть (доступ арендатора и статус), которая хранится и генерируется один раз.
+
+namespace {
+
+size_t count_nodes(const query_craft::condition_group& node)
+{
+    if(node.is_leaf())
+        return 1;
+
+    return 1 + (node.left() != nullptr ? count_nodes(*node.left()) : 0) + (node.right() != nullptr ? count_nodes(*node.right()) : 0);
+}
+
+} // namespace
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("orders", "shop",
+        column_info("id", primary_key()),
+        column_info("tenant_id"),
+        column_info("status"),
+        column_info("created"));
+
+    const auto tenant = table.column("tenant_id");
+    const auto status = table.column("status");
+    const auto created = table.column("created");
+
+    // Общая часть фильтров
+    const auto access = (tenant == std::string("42")) && status.in(std::string("new"), std::string("paid"), std::string("sent"));
+
+    std::vector<condition_group> filters;
+    for(int i = 0; i < 1000; i++)
+        filters.push_back(access && (created >= std::to_string(i % 100)));
+
+    condition_interner interner;
+    std::vector<condition_interner::interned> interned;
+
+    size_t total_nodes = 0;
+    for(const auto& filter : filters) {
+        total_nodes += count_nodes(filter);
+        interned.push_back(interner.intern(filter));
+    }
+
+    std::cout << "nodes: " << total_nodes << " -> " << interner.size() << "\n";
+
+    // Одинаковые условия, построенные независимо, совпадают по указателю
+    const auto first = interner.intern((tenant == std::string("42")) && status.in(std::string("new"), std::string("paid"), std::string("sent")));
+    const auto second = interner.intern((tenant == std::string("42")) && status.in(std::string("new"), std::string("paid"), std::string("sent")));
+
+    std::cout << "same pointer: " << (first == second && first.get() == interned.front()->left() ? "yes" : "no") << "\n";
+
+    const auto combined = interner.and_(first, interner.intern(created >= std::string("7")));
+    std::cout << "combined is shared: " << (combined == interned[7] ? "yes" : "no") << "\n";
+
+    // Проверка, что общие узлы генерируют тот же SQL
+    for(size_t i = 0; i < filters.size(); i++) {
+        if(interned[i]->unwrap(condion_view_type::full_name) != filters[i].unwrap(condion_view_type::full_name)) {
+            std::cout << "mismatch: " << filters[i].unwrap(condion_view_type::full_name) << "\n";
+            return 1;
+        }
+    }
+
+    std::cout << interned.front()->unwrap(condion_view_type::full_name) << "\n";
+
+    // Сравнение скорости повторной генерации SQL
+    constexpr int rounds = 200;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t plain_size = 0;
+    for(int round = 0; round < rounds; round++) {
+        for(const auto& filter : filters)
+            plain_size += filter.unwrap(condion_view_type::full_name).size();
+    }
+    const auto plain = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    size_t shared_size = 0;
+    for(int round = 0; round < rounds; round++) {
+        for(const auto& filter : interned)
+            shared_size += filter->unwrap(condion_view_type::full_name).size();
+    }
+    const auto shared = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+    const auto renders = static_cast<double>(rounds * filters.size());
+    std::cout << "unwrap: " << plain / renders << " us, interned: " << shared / renders << " us"
+              << (plain_size == shared_size ? "" : " (size mismatch)") << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует замену условий LIKE с постоянным префиксом на диапазоны, использующие индекс.
+/// Замена допустима только для столбцов с COLLATE "C" и LIKE с учетом регистра
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("email"));
+
+    const auto condition = table.column("name").like("abc%")
+        && (table.column("email").like("%@example.com") || table.column("email").like("user\\_1%"))
+        && table.column("id").like("42");
+
+    // Условия без постоянного префикса не изменяются, о них сообщает функция диагностики.
+    // Исходное условие LIKE сохраняется и отбрасывает лишние строки диапазона
+    const auto rewritten = rewrite_prefix_like(condition, [](const condition_info& like) {
+        std::cout << "non-sargable: " << like.unwrap(condion_view_type::full_name) << "\n";
+    });
+
+    std::cout << table.select_sql({}, condition) << "\n";
+    std::cout << table.select_sql({}, rewritten) << "\n";
+
+    // Диапазон без повторной проверки
+    std::cout << rewrite_prefix_like(table.column("name").like("яz%"), {}, false).unwrap() << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+#include <vector>
+
+/// Данный пример демонстрирует проверку параметров запросов на медленные шаблоны до генерации SQL
+
+namespace {
+
+void print(const std::vector<query_craft::lint_warning>& warnings)
+{
+    for(const auto& warning : warnings) {
+        switch(warning.level) {
+            case query_craft::lint_warning::severity::info:
+                std::cout << "[info] ";
+                break;
+            case query_craft::lint_warning::severity::warning:
+                std::cout << "[warning] ";
+                break;
+            case query_craft::lint_warning::severity::error:
+                std::cout << "[error] ";
+                break;
+        }
+
+        std::cout << warning.message << "\n";
+    }
+}
+
+} // namespace
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("amount"));
+
+    const query_linter linter;
+
+    std::vector<int> ids(5000);
+    for(size_t i = 0; i < ids.size(); i++)
+        ids[i] = static_cast<int>(i);
+
+    const auto condition = table.column("name").like("%smith") && table.column("amount").in_list(ids.begin(), ids.end());
+
+    print(linter.check_select({}, condition, { random_sort() }, 0, 200000));
+
+    // Выборка по первичному ключу не требует LIMIT
+    print(linter.check_select({}, table.column("id") == 5));
+
+    print(linter.check_remove());
+
+    // Строгий режим отклоняет изменение всей таблицы
+    query_linter::settings settings;
+    settings.strict = true;
+
+    try {
+        query_linter(settings).check_update();
+    } catch(const std::logic_error& error) {
+        std::cout << error.what() << "\n";
+    }
+
+    return 0;
+}
\ No newline at end of file
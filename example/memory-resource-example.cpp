@@ -0,0 +1,89 @@
+#include <QueryCraft/querycraft.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+
+/// Данный пример демонстрирует построение условий запроса на арене, освобождаемой одним вызовом.
+/// Возвращает ненулевой код, если построение условия и генерация запроса обращаются к глобальной куче.
+
+namespace {
+
+size_t allocations = 0;
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+
+    if(auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("c1"),
+        column_info("c2"),
+        column_info("c3"));
+
+    // Буфер на стеке, из которого будут выделяться узлы дерева условий и длинные списки значений
+    char buffer[8192];
+    memory::monotonic_buffer_resource arena(buffer, sizeof(buffer));
+
+    // Запрос генерируется в переиспользуемый буфер
+    std::string sql;
+    sql.reserve(1024);
+
+    bool failed = false;
+
+    for(int request = 0; request < 3; request++) {
+        const auto before = allocations;
+
+        {
+            // Все узлы дерева условий внутри области выделяются из арены
+            memory::scoped_resource scope(&arena);
+
+            const auto condition = table.column("c1") > request
+                && (table.column("c2").is_null() || table.column("c3").in(1, 2, 3));
+
+            sql.clear();
+            table.remove_sql(sql, condition);
+        }
+
+        const auto heap_allocations = allocations - before;
+
+        std::cout << sql << "\n";
+        std::cout << "global heap allocations: " << heap_allocations << ", arena blocks alive: " << arena.outstanding() << "\n";
+
+        // Первый запрос прогревает статические объекты, далее глобальная куча не используется
+        if(request != 0 && heap_allocations != 0)
+            failed = true;
+
+        // Дерево условий уничтожено, память арены возвращается одним вызовом.
+        // Живой блок означал бы копию условия, пережившую область и ссылающуюся на освобождаемую память
+        if(arena.outstanding() != 0)
+            failed = true;
+
+        arena.release();
+    }
+
+    return failed ? 1 : 0;
+}
\ No newline at end of file
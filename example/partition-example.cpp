@@ -0,0 +1,30 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует разбиение выборки на непересекающиеся запросы по диапазонам ключа для параллельного чтения
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("id", primary_key()),
+        column_info("c2"),
+        column_info("c3"));
+
+    // 4 запроса по равномерным диапазонам ключа из [1, 1000000]
+    for(const auto& sql : partition_select_sql(table, table.column("id"), 1, 1000000, 4, table.column("c2").not_null()))
+        std::cout << sql << "\n";
+
+    // Явно заданные границы
+    for(const auto& sql : partition_select_sql(table, table.column("id"), std::vector<int> { 100, 200 }))
+        std::cout << sql << "\n";
+
+    // Столбцы выборки передаются списком, как в sql_table::select_sql
+    for(const auto& sql : partition_select_sql(table, table.column("id"), std::vector<int> { 100 }, {}, {}, { table.column("id"), table.column("c2") }))
+        std::cout << sql << "\n";
+
+    return 0;
+}
\ No newline at end of file
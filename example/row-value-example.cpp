@@ -0,0 +1,37 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/// Данный пример демонстрирует поиск строк по составному ключу через условие "(a, b) IN ((..), (..))"
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("tenant_id", primary_key()),
+        column_info("id", primary_key()),
+        column_info("name"));
+
+    const std::vector<column_info> key = { table.column("tenant_id"), table.column("id") };
+
+    const std::vector<std::tuple<int, int>> keys = { std::make_tuple(1, 10), std::make_tuple(1, 11), std::make_tuple(2, 10) };
+    std::cout << table.select_sql({}, row_in(key, keys)) << "\n";
+
+    // Кавычки внутри значений экранируются
+    const std::vector<std::pair<int, std::string>> names = { { 1, "O'Brien" }, { 2, "plain" } };
+    std::cout << table.remove_sql(row_in({ table.column("tenant_id"), table.column("name") }, names)) << "\n";
+
+    // Длинные списки разбиваются на части
+    std::vector<std::tuple<int, int>> many;
+    for(int i = 0; i < 5; i++)
+        many.emplace_back(i, i * 10);
+
+    std::cout << row_in(key, many, 2).unwrap(condion_view_type::full_name) << "\n";
+
+    return 0;
+}
\ No newline at end of file
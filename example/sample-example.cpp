@@ -0,0 +1,31 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует выборку случайных строк без сортировки всей таблицы
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("table_name", "schema_name",
+        column_info("id", primary_key()),
+        column_info("c2"),
+        column_info("c3"));
+
+    // PostgreSQL: примерно 1% страниц таблицы, не более 10 строк
+    std::cout << table.sample_select_sql(system_sample(1), {}, table.column("c2").not_null(), {}, 10) << "\n";
+
+    // PostgreSQL: воспроизводимая выборка 0.5% строк
+    std::cout << table.sample_select_sql(repeatable(bernoulli_sample(0.5), 42)) << "\n";
+
+    // SQLite: 5 случайных строк по случайным значениям первичного ключа из диапазона [1, 1000000].
+    // Запрашивается больше ключей, лишние найденные строки отбрасываются в случайном порядке
+    std::cout << table.random_keys_select_sql(table.column("id"), 1, 1000000, 5, 42) << "\n";
+
+    // Небольшой диапазон [1, 8]: 5 ключей без повторов выбираются перемешиванием, запрос вернет до 5 строк
+    std::cout << table.random_keys_select_sql(table.column("id"), 1, 8, 5, 42) << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <QueryCraft/querycraft.h>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Данный пример демонстрирует изменяемый запрос на выборку для постраничного вывода.
+/// Между страницами меняется только смещение, поэтому заново генерируется только часть LIMIT/OFFSET.
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблицах
+    const sql_table users("users", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("city_id"));
+
+    const sql_table cities("cities", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("country"));
+
+    const std::vector<join_column> joins { { join_column::type::left, cities, users.column("city_id").equals(cities.column("id")) } };
+
+    // Большое условие, генерация которого занимает основное время
+    condition_group condition = users.column("name").like("I%");
+    for(int i = 0; i < 50; i++)
+        condition = condition && (cities.column("country") != std::to_string(i));
+
+    const std::vector<sort_column> sorts { asc_sort(users.column("name")), desc_sort(users.column("id")) };
+
+    select_query query(users);
+    query.joins(joins).where(condition).order_by(sorts).limit(20);
+
+    // Проверка, что результат совпадает с select_sql при любых изменениях
+    for(size_t page = 0; page < 5; page++) {
+        query.offset(page * 20);
+
+        if(query.sql() != users.select_sql(joins, condition, sorts, 20, page * 20)) {
+            std::cout << "mismatch: " << query.sql() << "\n";
+            return 1;
+        }
+    }
+
+    query.columns({ users.column("id"), cities.column("name") }).where(users.column("id") > 10);
+    if(query.sql() != users.select_sql(joins, users.column("id") > 10, sorts, 20, 80, { users.column("id"), cities.column("name") })) {
+        std::cout << "mismatch: " << query.sql() << "\n";
+        return 1;
+    }
+
+    std::cout << query.sql() << "\n";
+
+    // Сравнение скорости при смене только смещения
+    query.where(condition).columns({});
+
+    constexpr int pages = 20000;
+
+    auto start = std::chrono::steady_clock::now();
+    size_t full_size = 0;
+    for(int page = 0; page < pages; page++)
+        full_size += users.select_sql(joins, condition, sorts, 20, static_cast<size_t>(page) * 20).size();
+    const auto full = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    size_t incremental_size = 0;
+    for(int page = 0; page < pages; page++)
+        incremental_size += query.offset(static_cast<size_t>(page) * 20).sql().size();
+    const auto incremental = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "select_sql: " << full / pages << " ns, select_query: " << incremental / pages << " ns per page"
+              << (full_size == incremental_size ? "" : " (size mismatch)") << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+#include <stdexcept>
+
+/// Данный пример демонстрирует распределение строк и запросов по шардам таблицы
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о логической таблице
+    const table orders("orders", "public",
+        column_info("id", primary_key()),
+        column_info("customer"),
+        column_info("amount"));
+
+    // Шарды orders_0..orders_3 с распределением по хешу столбца id
+    sharded_table sharded(orders, 4, "id");
+
+    for(int i = 0; i < 10; i++)
+        sharded.add_row_args(i, "customer", i * 100);
+
+    // По одному запросу на каждый непустой шард
+    for(const auto& statement : sharded.insert_sql())
+        std::cout << "shard " << statement.shard << ": " << statement.sql << "\n";
+
+    // Условие по ключу затрагивает только шарды с указанными значениями
+    for(const auto& statement : sharded.select_sql({}, sharded.column("id").in(1, 2) && sharded.column("amount") > 50))
+        std::cout << "shard " << statement.shard << ": " << statement.sql << "\n";
+
+    // Условие без ключа рассылается на все шарды, смещение применяется при слиянии результатов
+    for(const auto& statement : sharded.select_sql({}, sharded.column("amount") > 50, {}, 10, 20, { sharded.column("id") }))
+        std::cout << "shard " << statement.shard << ": " << statement.sql << "\n";
+
+    for(const auto& statement : sharded.remove_sql(sharded.column("id") == 7))
+        std::cout << "shard " << statement.shard << ": " << statement.sql << "\n";
+
+    // Распределение по диапазонам ключа: (-inf, 1000), [1000, 2000), [2000, +inf)
+    sharded_table ranged(orders, 3, "id", range_router({ 1000, 2000 }));
+
+    for(const auto& statement : ranged.select_sql({}, ranged.column("id") == 1500 || ranged.column("id").is_null()))
+        std::cout << "shard " << statement.shard << ": " << statement.sql << "\n";
+
+    // Вложенный запрос к другой таблице переносится на шарды без изменений
+    const sql_table customers("customers", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("blocked"));
+
+    const auto blocked = customers.sub_select({}, customers.column("blocked") == true, {}, 0, 0, { customers.column("id") });
+
+    for(const auto& statement : sharded.select_sql({}, sharded.column("customer").not_in(blocked)))
+        std::cout << "shard " << statement.shard << ": " << statement.sql << "\n";
+
+    // Вложенный запрос к логической таблице на шарде читал бы несуществующую таблицу orders и отклоняется
+    const sql_table logical(orders);
+
+    try {
+        sharded.select_sql({}, sharded.column("id").in(logical.sub_select({}, logical.column("amount") > 1000, {}, 0, 0, { logical.column("id") })));
+        std::cout << "sub-query to the logical table: not rejected\n";
+        return 1;
+    } catch(const std::invalid_argument& error) {
+        std::cout << "sub-query to the logical table: " << error.what() << "\n";
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include <QueryCraft/querycraft.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <vector>
+
+/// Данный пример считает выделения памяти при построении типичных фильтров.
+/// Одно значение условия хранится внутри условия, список IN размещается в куче одним блоком.
+
+namespace {
+
+size_t allocations = 0;
+size_t allocated_bytes = 0;
+
+struct allocation_counter
+{
+    allocation_counter()
+        : _allocations(allocations)
+        , _bytes(allocated_bytes)
+    {
+    }
+
+    size_t allocations_count() const
+    {
+        return allocations - _allocations;
+    }
+
+    size_t bytes() const
+    {
+        return allocated_bytes - _bytes;
+    }
+
+private:
+    size_t _allocations;
+    size_t _bytes;
+};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    allocations++;
+    allocated_bytes += size;
+
+    if(auto* p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    const sql_table table("orders", "shop",
+        column_info("id", primary_key()),
+        column_info("status"),
+        column_info("created"));
+
+    const auto id = table.column("id");
+    const auto status = table.column("status");
+    const auto created = table.column("created");
+
+    constexpr int count = 100000;
+
+    std::vector<condition_info> conditions;
+    conditions.reserve(count);
+
+    {
+        // Условия с одним значением
+        allocation_counter counter;
+        for(int i = 0; i < count; i++)
+            conditions.push_back(id == i);
+
+        std::cout << "id = value: " << static_cast<double>(counter.allocations_count()) / count << " allocations, "
+                  << static_cast<double>(counter.bytes()) / count << " heap bytes, "
+                  << sizeof(condition_info) << " inline bytes per predicate\n";
+    }
+
+    conditions.clear();
+
+    {
+        // Список IN размещается в куче одним блоком независимо от длины
+        allocation_counter counter;
+        for(int i = 0; i < count; i++)
+            conditions.push_back(status.in(std::string("new"), std::string("paid")));
+
+        std::cout << "status IN (2 values): " << static_cast<double>(counter.allocations_count()) / count << " allocations\n";
+    }
+
+    conditions.clear();
+
+    {
+        allocation_counter counter;
+        for(int i = 0; i < count; i++)
+            conditions.push_back(status.in(std::string("new"), std::string("paid"), std::string("sent"), std::string("done")));
+
+        std::cout << "status IN (4 values): " << static_cast<double>(counter.allocations_count()) / count << " allocations\n";
+    }
+
+    conditions.clear();
+
+    {
+        // Для сравнения: те же значения в std::vector
+        allocation_counter counter;
+        std::vector<std::vector<std::string>> values;
+        values.reserve(count);
+
+        for(int i = 0; i < count; i++)
+            values.push_back({ std::to_string(i) });
+
+        std::cout << "std::vector with one value: " << static_cast<double>(counter.allocations_count()) / count << " allocations, "
+                  << static_cast<double>(counter.bytes()) / count << " heap bytes\n";
+    }
+
+    // Значения копируются в std::vector для кода, который работал со списком значений как с вектором
+    const std::vector<std::string> values = status.in(std::string("new"), std::string("paid")).values();
+    std::cout << "values as std::vector: " << values.size() << "\n";
+
+    // Типичный фильтр из трех условий
+    allocation_counter counter;
+
+    const auto start = std::chrono::steady_clock::now();
+    size_t size = 0;
+    for(int i = 0; i < count; i++) {
+        const auto filter = (id > i) && (status == std::string("paid")) && (created >= std::string("2024-01-01"));
+        size += filter.estimate_size(condion_view_type::full_name);
+    }
+    const auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "3-predicate filter: " << static_cast<double>(counter.allocations_count()) / count << " allocations, "
+              << elapsed / count << " ns (" << size / count << " chars)\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует сборку нескольких запросов в один скрипт для выполнения за один сетевой обмен.
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблице
+    sql_table users("users", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("age"));
+
+    sql_script::settings settings;
+    settings.transaction = true;
+    settings.max_size = 512;
+
+    sql_script script(settings);
+
+    // Запросы генерируются сразу в буфер скрипта
+    users.add_row_args(1, "Alice", 30);
+    users.add_row_args(2, "Bob", 25);
+    script.add_rendered([&users](std::string& out) { users.insert_sql(out); });
+
+    script.savepoint("before_cleanup");
+    script.add_rendered([&users](std::string& out) { users.remove_sql(out, users.column("age") < 18); });
+    script.release_savepoint("before_cleanup");
+
+    script.add("SELECT COUNT(*) FROM public.users");
+
+    // Запрос, не помещающийся в ограничение размера, не добавляется
+    for(int i = 0; i < 100; i++)
+        users.add_row_args(100 + i, "User " + std::to_string(i), 20);
+
+    if(!script.add_rendered([&users](std::string& out) { users.insert_sql(out); }))
+        std::cout << "Rejected statement of " << script.rejected().size() << " bytes\n\n";
+
+    const auto& sql = script.sql();
+    std::cout << sql << "\n\n";
+
+    // Запросы по отдельности для режима конвейера
+    const auto& statements = script.statements();
+    for(size_t i = 0; i < statements.size(); i++)
+        std::cout << i << ": [" << statements[i].offset << ", " << statements[i].size << ") " << script.statement_sql(i) << "\n";
+
+    // Сопоставление позиции из сообщения об ошибке с запросом
+    const auto position = sql.find("COUNT");
+    std::cout << "\nPosition " << position << " belongs to statement " << script.find_statement(position) << "\n";
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include <QueryCraft/querycraft.h>
+#include <QueryCraft/sqlite/sqliteexecutor.h>
+
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+/// Данный пример сравнивает результат compiled_condition с результатом того же условия во встроенной базе данных SQLite
+/// на случайных строках и условиях. Столбцы содержат вперемешку числа и строки, шаблоны LIKE содержат '\\' и буквы разного регистра.
+/// Проверяются столбцы с числовым и с текстовым типом: способ сравнения определяется типом столбца, а не видом значений.
+/// Возвращает ненулевой код при расхождении.
+
+namespace {
+
+using namespace query_craft;
+
+constexpr size_t row_count = 500;
+constexpr size_t condition_count = 2000;
+
+/// Генератор случайных значений и условий по столбцам таблицы.
+class condition_generator
+{
+public:
+    explicit condition_generator(const sql_table& table)
+        : _id(table.column("id"))
+        , _name(table.column("name"))
+        , _amount(table.column("amount"))
+    {
+    }
+
+    condition_group next(const size_t depth = 0)
+    {
+        if(depth < 3 && pick(3) == 0) {
+            const auto left = next(depth + 1);
+            const auto right = next(depth + 1);
+
+            return pick(2) == 0 ? left && right : left || right;
+        }
+
+        return leaf();
+    }
+
+    /// Число или строка. Числа записаны в каноническом виде, чтобы SQLite хранил их без изменения текста.
+    std::string value()
+    {
+        switch(pick(4)) {
+            case 0:
+                return std::to_string(static_cast<int>(pick(100)) - 20);
+            case 1:
+                return std::to_string(static_cast<int>(pick(20)) - 5) + ".5";
+            case 2:
+                return std::to_string(pick(10)) + text(1);
+            default:
+                return text(1 + pick(3));
+        }
+    }
+
+    size_t pick(const size_t count)
+    {
+        return std::uniform_int_distribution<size_t>(0, count - 1)(_random);
+    }
+
+private:
+    std::string text(const size_t length)
+    {
+        static const char alphabet[] = { 'a', 'b', 'A', 'B', '\\', '%', '_' };
+
+        std::string result;
+        for(size_t i = 0; i < length; i++)
+            result.push_back(alphabet[pick(sizeof(alphabet))]);
+
+        return result;
+    }
+
+    std::string pattern()
+    {
+        static const char alphabet[] = { 'a', 'b', 'A', 'B', '1', '\\', '%', '_' };
+
+        std::string result;
+        const auto length = 1 + pick(4);
+
+        for(size_t i = 0; i < length; i++)
+            result.push_back(alphabet[pick(sizeof(alphabet))]);
+
+        return result;
+    }
+
+    condition_group leaf()
+    {
+        const auto& column = pick(2) == 0 ? _name : _amount;
+
+        switch(pick(12)) {
+            case 0:
+                return column == value();
+            case 1:
+                return column != value();
+            case 2:
+                return column < value();
+            case 3:
+                return column <= value();
+            case 4:
+                return column > value();
+            case 5:
+                return column >= value();
+            case 6:
+                return column.in(value(), value(), value());
+            case 7:
+                return column.notIn(value(), value());
+            case 8:
+                return column.is_null();
+            case 9:
+                return column.not_null();
+            case 10:
+                return _id.in(std::to_string(pick(row_count)), std::to_string(pick(row_count)));
+            default:
+                return column.like(pattern());
+        }
+    }
+
+private:
+    std::mt19937 _random { 7 };
+
+    column_info _id;
+    column_info _name;
+    column_info _amount;
+};
+
+/**
+ * Сравнивает результаты для случайных условий.
+ * @return Количество расхождений.
+ */
+size_t check(const std::string& name, sqlite::executor& db, const sql_table& table, const std::vector<compiled_condition::row>& rows,
+    const compiled_condition::settings& settings)
+{
+    condition_generator generator(table);
+    size_t mismatches = 0;
+
+    for(size_t i = 0; i < condition_count; i++) {
+        const auto condition = generator.next();
+
+        std::set<std::string> expected;
+        for(const auto& row : compiled_condition(condition, table, settings).filter(rows))
+            expected.insert(row.front());
+
+        std::set<std::string> actual;
+        db.query(table.select_sql({}, condition, {}, 0, 0, { table.column("id") }), [&actual](const sqlite::executor::row& row) {
+            actual.insert(row.front());
+        });
+
+        if(expected != actual) {
+            if(mismatches++ < 10) {
+                std::cout << "Mismatch: " << condition.unwrap(condion_view_type::full_name) << "\n"
+                          << "  compiled_condition: " << expected.size() << " rows, SQLite: " << actual.size() << " rows\n";
+            }
+        }
+    }
+
+    std::cout << name << ": " << condition_count << " conditions checked, " << mismatches << " mismatches\n";
+
+    return mismatches;
+}
+
+} // namespace
+
+int main()
+{
+    // Объявление информации о таблице
+    sql_table table("items", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("amount"));
+
+    sqlite::executor db;
+    db.create_table(table, "NUMERIC");
+
+    // Те же строки в таблице с текстовыми столбцами
+    sqlite::executor text_db;
+    text_db.create_table(table, "TEXT");
+
+    condition_generator generator(table);
+
+    std::vector<compiled_condition::row> rows;
+    for(size_t i = 0; i < row_count; i++) {
+        rows.push_back({ std::to_string(i),
+            generator.pick(10) == 0 ? column_info::null_value() : generator.value(),
+            generator.pick(10) == 0 ? column_info::null_value() : generator.value() });
+    }
+
+    table.add_rows(rows.begin(), rows.end());
+    const auto insert = table.insert_sql();
+    db.execute(insert);
+    text_db.execute(insert);
+
+    // INSERT удваивает '\\' в значениях, а условия передают его как есть, поэтому строки для сравнения читаются из базы данных
+    rows = db.query(table.select_sql({}, {}, { asc_sort(table.column("id")) }));
+
+    // Поведение SQLite по умолчанию: LIKE без учета регистра и без символа экранирования, числа меньше строк
+    auto settings = compiled_condition::sqlite_settings();
+    settings.numeric_columns = { "id", "name", "amount" };
+    auto mismatches = check("SQLite defaults", db, table, rows, settings);
+
+    // Текстовые столбцы: числа сравниваются как строки, '10' < '9'
+    auto text_settings = compiled_condition::sqlite_settings();
+    mismatches += check("TEXT columns", text_db, table, rows, text_settings);
+
+    // LIKE с учетом регистра
+    db.execute("PRAGMA case_sensitive_like = ON;");
+    settings.case_sensitive_like = true;
+    mismatches += check("case-sensitive LIKE", db, table, rows, settings);
+
+    return mismatches == 0 ? 0 : 1;
+}
\ No newline at end of file
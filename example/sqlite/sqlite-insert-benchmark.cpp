@@ -0,0 +1,107 @@
+#include <QueryCraft/querycraft.h>
+#include <QueryCraft/sqlite/sqliteexecutor.h>
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+/// Данный пример замеряет скорость вставки во встроенную базу данных SQLite
+/// в запросах и строках в секунду для разного количества строк в одном запросе INSERT
+
+namespace {
+
+using namespace query_craft;
+
+constexpr size_t row_count = 50000;
+
+/// Выполняет замер и выводит количество запросов и строк в секунду.
+void measure(const std::string& name, sqlite::executor& db, const sql_table& users, const std::function<size_t()>& run)
+{
+    db.execute(users.remove_sql());
+
+    const auto start = std::chrono::steady_clock::now();
+    const auto statements = run();
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto inserted = std::stoul(db.query(users.count_sql()).front().front());
+    if(inserted != row_count)
+        throw std::logic_error("Ошибка. Вставлено " + std::to_string(inserted) + " строк вместо " + std::to_string(row_count));
+
+    std::cout << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << statements / seconds << " statements/s"
+              << std::setw(12) << row_count / seconds << " rows/s\n";
+}
+
+} // namespace
+
+int main()
+{
+    // Объявление информации о таблице
+    sql_table users("users", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("age"),
+        column_info("email"));
+
+    sqlite::executor db;
+    db.create_table(users, "NUMERIC");
+
+    const auto add_row = [&users](const size_t i) {
+        users.emplace_row(i, "user " + std::to_string(i), i % 90, "user" + std::to_string(i) + "@example.com");
+    };
+
+    // Каждая строка отдельным запросом с автоматической фиксацией
+    measure("row per statement, autocommit", db, users, [&]() {
+        for(size_t i = 0; i < row_count; i++) {
+            add_row(i);
+            db.execute(users.insert_sql());
+        }
+
+        return row_count;
+    });
+
+    // Каждая строка отдельным запросом внутри одного скрипта с транзакцией
+    measure("row per statement, one script", db, users, [&]() {
+        sql_script::settings settings;
+        settings.transaction = true;
+
+        sql_script script(settings);
+        for(size_t i = 0; i < row_count; i++) {
+            add_row(i);
+            script.add_rendered([&users](std::string& out) { users.insert_sql(out); });
+        }
+
+        db.execute(script.sql());
+
+        return script.size();
+    });
+
+    // Многострочные запросы INSERT разного размера в одной транзакции
+    for(const size_t batch : { 10, 100, 1000, 10000 }) {
+        measure("multi-row INSERT x" + std::to_string(batch), db, users, [&]() {
+            size_t statements = 0;
+            std::string sql;
+
+            db.execute("BEGIN;");
+
+            for(size_t i = 0; i < row_count; i++) {
+                add_row(i);
+
+                if((i + 1) % batch == 0 || i + 1 == row_count) {
+                    sql.clear();
+                    users.insert_sql(sql);
+                    db.execute(sql);
+                    statements++;
+                }
+            }
+
+            db.execute("COMMIT;");
+
+            return statements;
+        });
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <QueryCraft/querycraft.h>
+#include <QueryCraft/sqlite/sqliteexecutor.h>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Данный пример замеряет скорость выборки из встроенной базы данных SQLite в запросах и строках в секунду:
+/// поиск по списку ключей через отдельные запросы, IN, IN по частям и OR, а также постраничную выборку через OFFSET и по ключу
+
+namespace {
+
+using namespace query_craft;
+
+constexpr size_t row_count = 20000;
+constexpr size_t key_count = 2000;
+constexpr size_t page_size = 100;
+
+/// Результат выполнения стратегии.
+struct result
+{
+    size_t statements = 0;
+    size_t rows = 0;
+};
+
+/// Выполняет замер и выводит количество запросов и строк в секунду.
+void measure(const std::string& name, const size_t expected_rows, const std::function<result()>& run)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    result measured;
+    try {
+        measured = run();
+    } catch(const sqlite::error& error) {
+        // Например, длинная цепочка OR превышает глубину стека разбора SQLite
+        std::cout << std::left << std::setw(28) << name << error.what() << "\n";
+        return;
+    }
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if(measured.rows != expected_rows)
+        throw std::logic_error("Ошибка. Получено " + std::to_string(measured.rows) + " строк вместо " + std::to_string(expected_rows));
+
+    std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(0)
+              << std::setw(12) << measured.statements / seconds << " statements/s"
+              << std::setw(12) << measured.rows / seconds << " rows/s\n";
+}
+
+} // namespace
+
+int main()
+{
+    // Объявление информации о таблице
+    sql_table users("users", "public",
+        column_info("id", primary_key()),
+        column_info("name"),
+        column_info("age"));
+
+    const auto id = users.column("id");
+
+    sqlite::executor db;
+    db.create_table(users, "NUMERIC");
+
+    for(size_t i = 0; i < row_count; i++)
+        users.emplace_row(i, "user " + std::to_string(i), i % 90);
+
+    db.execute(users.insert_sql());
+
+    // Случайные различные ключи для поиска
+    std::vector<size_t> keys(row_count);
+    for(size_t i = 0; i < row_count; i++)
+        keys[i] = i;
+
+    std::shuffle(keys.begin(), keys.end(), std::mt19937(42));
+    keys.resize(key_count);
+
+    const auto count_rows = [&db](const std::string& sql) { return db.query(sql, [](const sqlite::executor::row&) {}); };
+
+    std::cout << "Lookup of " << key_count << " keys\n";
+
+    measure("statement per key", key_count, [&]() {
+        result measured;
+
+        for(const auto key : keys) {
+            measured.rows += count_rows(users.select_sql({}, id == key));
+            measured.statements++;
+        }
+
+        return measured;
+    });
+
+    measure("one IN list", key_count, [&]() {
+        return result { 1, count_rows(users.select_sql({}, id.in_list(keys.begin(), keys.end()))) };
+    });
+
+    for(const size_t chunk : { 10, 100 }) {
+        measure("IN lists of " + std::to_string(chunk), key_count, [&, chunk]() {
+            result measured;
+
+            for(size_t i = 0; i < keys.size(); i += chunk) {
+                const auto last = keys.begin() + static_cast<std::ptrdiff_t>(std::min(i + chunk, keys.size()));
+                measured.rows += count_rows(users.select_sql({}, id.in_list(keys.begin() + static_cast<std::ptrdiff_t>(i), last)));
+                measured.statements++;
+            }
+
+            return measured;
+        });
+    }
+
+    for(const size_t chain : { size_t(10), key_count }) {
+        measure("OR chains of " + std::to_string(chain), key_count, [&, chain]() {
+            result measured;
+
+            for(size_t i = 0; i < keys.size(); i += chain) {
+                condition_group condition;
+                for(size_t j = i; j < std::min(i + chain, keys.size()); j++)
+                    condition = condition.is_valid() ? condition || (id == keys[j]) : condition_group(id == keys[j]);
+
+                measured.rows += count_rows(users.select_sql({}, condition));
+                measured.statements++;
+            }
+
+            return measured;
+        });
+    }
+
+    std::cout << "\nReading all rows by pages of " << page_size << "\n";
+
+    measure("LIMIT / OFFSET", row_count, [&]() {
+        result measured;
+
+        for(size_t offset = 0;; offset += page_size) {
+            const auto rows = count_rows(users.select_sql({}, {}, { asc_sort(id) }, page_size, offset));
+            measured.statements++;
+            measured.rows += rows;
+
+            if(rows < page_size)
+                break;
+        }
+
+        return measured;
+    });
+
+    measure("keyset", row_count, [&]() {
+        result measured;
+        std::string last_id;
+
+        for(;;) {
+            const auto condition = last_id.empty() ? condition_group() : condition_group(id > last_id);
+
+            size_t rows = 0;
+            db.query(users.select_sql({}, condition, { asc_sort(id) }, page_size), [&rows, &last_id](const sqlite::executor::row& row) {
+                last_id = row.front();
+                rows++;
+            });
+
+            measured.statements++;
+            measured.rows += rows;
+
+            if(rows < page_size)
+                break;
+        }
+
+        return measured;
+    });
+
+    return 0;
+}
\ No newline at end of file
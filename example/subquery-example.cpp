@@ -0,0 +1,39 @@
+#include <QueryCraft/querycraft.h>
+
+#include <iostream>
+
+/// Данный пример демонстрирует использование вложенных запросов в условиях IN, NOT IN, EXISTS и NOT EXISTS
+
+int main()
+{
+    using namespace query_craft;
+
+    // Объявление информации о таблицах
+    const sql_table users("users", "public",
+        column_info("id"),
+        column_info("name"),
+        column_info("active"));
+
+    const sql_table orders("orders", "public",
+        column_info("id"),
+        column_info("user_id"),
+        column_info("total"));
+
+    // Пользователи, у которых есть заказы дороже 1000
+    std::cout << users.select_sql({},
+        users.column("id").in(orders.sub_select({}, orders.column("total") > 1000, {}, 0, 0, { orders.column("user_id") })))
+              << "\n";
+
+    // Коррелированный подзапрос: пользователи без заказов
+    std::cout << users.select_sql({},
+        not_exists(orders.sub_select({}, orders.column("user_id").equals(users.column("id")), {}, 0, 0, { orders.column("id") })))
+              << "\n";
+
+    // Удаление неактивных пользователей, у которых есть заказы
+    std::cout << users.remove_sql(
+        users.column("active") == false
+        && exists(orders.sub_select({}, orders.column("user_id").equals(users.column("id")))))
+              << "\n";
+
+    return 0;
+}
\ No newline at end of file
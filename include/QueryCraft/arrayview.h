@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+namespace query_craft {
+
+/// Непрерывный диапазон элементов без владения (аналог std::span, недоступного в C++14).
+/// Позволяет принимать std::vector и список инициализации одним параметром без создания временного вектора.
+/// Диапазон действителен, пока существует источник, поэтому используется только для параметров функций.
+///
+/// Список инициализации допустим только как аргумент вызова: массив списка живет до конца полного выражения,
+/// содержащего вызов. Переменная, инициализированная списком (array_view<column_info> v = { a, b };),
+/// ссылается на уничтоженный массив сразу после объявления. Для хранения используйте std::vector или to_vector().
+template<typename T>
+class array_view
+{
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using const_iterator = const T*;
+    using iterator = const_iterator;
+
+public:
+    constexpr array_view() noexcept = default;
+
+    /**
+     * Конструктор с указанием начала и размера диапазона.
+     *
+     * @param data Указатель на первый элемент.
+     * @param size Количество элементов.
+     */
+    constexpr array_view(const T* data, const size_type size) noexcept
+        : _data(data)
+        , _size(size)
+    {
+    }
+
+    array_view(const std::vector<T>& values) noexcept
+        : _data(values.data())
+        , _size(values.size())
+    {
+    }
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#pragma GCC diagnostic push
+// GCC предупреждает о любом сохранении указателя на массив списка инициализации. Для аргумента функции
+// массив переживает вызов, а объявление переменной из списка запрещено правилом в описании класса.
+#pragma GCC diagnostic ignored "-Winit-list-lifetime"
+#endif
+    /**
+     * Конструктор из списка инициализации. Только для аргументов функций, см. описание класса.
+     *
+     * @param values Список значений, массив которого должен существовать дольше диапазона.
+     */
+    constexpr array_view(std::initializer_list<T> values) noexcept
+        : _data(values.begin())
+        , _size(values.size())
+    {
+    }
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9
+#pragma GCC diagnostic pop
+#endif
+
+    constexpr const_iterator begin() const noexcept
+    {
+        return _data;
+    }
+
+    constexpr const_iterator end() const noexcept
+    {
+        return _data + _size;
+    }
+
+    constexpr size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    constexpr bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    constexpr const T* data() const noexcept
+    {
+        return _data;
+    }
+
+    constexpr const T& operator[](const size_type index) const
+    {
+        return _data[index];
+    }
+
+    constexpr const T& front() const
+    {
+        return _data[0];
+    }
+
+    constexpr const T& back() const
+    {
+        return _data[_size - 1];
+    }
+
+    /**
+     * Копирует элементы диапазона в вектор.
+     * @return Вектор с копиями элементов.
+     */
+    std::vector<T> to_vector() const
+    {
+        return std::vector<T>(begin(), end());
+    }
+
+private:
+    const T* _data = nullptr;
+    size_type _size = 0;
+};
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "joincolumn.h"
+#include "sortcolumn.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace query_craft {
+
+/// Структура, описывающая запрос на выборку без привязки к SQL-представлению.
+/// Позволяет построить запрос в одном процессе, а сгенерировать SQL в другом.
+struct select_description
+{
+    /// Таблица, из которой выполняется выборка.
+    table source {};
+
+    /// Информация о join соединениях.
+    std::vector<join_column> joins {};
+
+    /// Условие для выбора строк.
+    condition_group condition {};
+
+    /// Информация о колонках необходимых для сортировок.
+    std::vector<sort_column> sorts {};
+
+    /// Лимит выборки.
+    size_t limit = 0;
+
+    /// Смещение выборки.
+    size_t offset = 0;
+
+    /// Столбцы для выборки. Если пусто, выбираются все столбцы.
+    std::vector<column_info> columns {};
+};
+
+/**
+ * Генерация SQL-запроса для выборки по описанию.
+ *
+ * @param description Описание запроса.
+ * @return SQL-запрос для выборки.
+ */
+std::string select_sql(const select_description& description);
+
+namespace codec {
+
+/// Текущая версия двоичного формата. Декодер принимает данные версий не выше текущей.
+constexpr uint8_t format_version = 1;
+
+/**
+ * Добавляет двоичное представление условия в конец буфера.
+ * Сохраняются столбцы, типы операторов и значения, поэтому условие можно восстановить без разбора SQL.
+ *
+ * @param out Буфер.
+ * @param condition Условие.
+ * @throw std::invalid_argument Если условие содержит пользовательский оператор.
+ */
+void encode(std::string& out, const condition_group& condition);
+
+/**
+ * Возвращает двоичное представление условия.
+ *
+ * @param condition Условие.
+ * @return Двоичные данные.
+ */
+std::string encode(const condition_group& condition);
+
+/**
+ * Добавляет двоичное представление описания выборки в конец буфера.
+ *
+ * @param out Буфер.
+ * @param description Описание выборки.
+ */
+void encode(std::string& out, const select_description& description);
+
+/**
+ * Возвращает двоичное представление описания выборки.
+ *
+ * @param description Описание выборки.
+ * @return Двоичные данные.
+ */
+std::string encode(const select_description& description);
+
+/**
+ * Восстанавливает условие из двоичного представления. Данные читаются на месте, без промежуточных копий буфера.
+ *
+ * @param data Указатель на начало данных.
+ * @param size Размер данных.
+ * @return Условие.
+ * @throw std::invalid_argument Если данные повреждены или записаны более новой версией формата.
+ */
+condition_group decode_condition(const char* data, size_t size);
+
+/**
+ * Восстанавливает условие из двоичного представления.
+ *
+ * @param data Двоичные данные.
+ * @return Условие.
+ */
+condition_group decode_condition(const std::string& data);
+
+/**
+ * Восстанавливает описание выборки из двоичного представления.
+ *
+ * @param data Указатель на начало данных.
+ * @param size Размер данных.
+ * @return Описание выборки.
+ * @throw std::invalid_argument Если данные повреждены или записаны более новой версией формата.
+ */
+select_description decode_select(const char* data, size_t size);
+
+/**
+ * Восстанавливает описание выборки из двоичного представления.
+ *
+ * @param data Двоичные данные.
+ * @return Описание выборки.
+ */
+select_description decode_select(const std::string& data);
+
+} // namespace codec
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "subquery.h"
+#include "table.h"
+
+#include <string>
+#include <vector>
+
+namespace query_craft {
+
+/// Структура, представляющая общее табличное выражение (WITH name (columns) AS (query)).
+/// Имя и столбцы выражения задаются таблицей, поэтому на выражение можно ссылаться в join и условиях как на обычную таблицу.
+struct common_table_expression
+{
+    /// Таблица, описывающая имя и столбцы выражения. Схема должна быть пустой.
+    table cte_table {};
+
+    /// Запрос, результат которого становится содержимым выражения.
+    sub_query query {};
+
+    /// Является ли выражение рекурсивным (WITH RECURSIVE).
+    bool recursive = false;
+};
+
+/**
+ * Создает общее табличное выражение.
+ *
+ * @param cte_table Таблица, описывающая имя и столбцы выражения.
+ * @param query Запрос, результат которого становится содержимым выражения.
+ * @return Общее табличное выражение.
+ */
+common_table_expression cte(const table& cte_table, sub_query query);
+
+/**
+ * Создает рекурсивное общее табличное выражение вида "anchor UNION [ALL] recursive_part".
+ *
+ * @param cte_table Таблица, описывающая имя и столбцы выражения.
+ * @param anchor Нерекурсивная часть, задающая начальные строки.
+ * @param recursive_part Рекурсивная часть, ссылающаяся на cte_table.
+ * @param union_all Использовать UNION ALL (по умолчанию) вместо UNION.
+ * @return Рекурсивное общее табличное выражение.
+ */
+common_table_expression recursive_cte(const table& cte_table, const sub_query& anchor, const sub_query& recursive_part, bool union_all = true);
+
+/**
+ * Добавляет к запросу общие табличные выражения (WITH [RECURSIVE] ...).
+ *
+ * @param out Буфер, в конец которого добавляется запрос.
+ * @param expressions Общие табличные выражения в порядке объявления.
+ * @param statement Основной запрос, который может ссылаться на выражения.
+ */
+void with_sql(std::string& out, const std::vector<common_table_expression>& expressions, const std::string& statement);
+
+/**
+ * Добавляет к запросу общие табличные выражения (WITH [RECURSIVE] ...).
+ *
+ * @param expressions Общие табличные выражения в порядке объявления.
+ * @param statement Основной запрос, который может ссылаться на выражения.
+ * @return Запрос с общими табличными выражениями.
+ */
+std::string with_sql(const std::vector<common_table_expression>& expressions, const std::string& statement);
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,223 @@
+#pragma once
+
+#include "table.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace query_craft {
+
+/// Класс, представляющий условие, скомпилированное для проверки строк в памяти без обращения к базе данных.
+/// Дерево условий преобразуется в плоский массив инструкций, столбцы заранее сопоставляются с номерами в строке,
+/// а числовые значения разбираются один раз при компиляции.
+///
+/// Семантика совпадает с генерируемым SQL: значение NULL дает неизвестный результат в сравнениях,
+/// AND и OR следуют трехзначной логике, строка подходит только при истинном результате.
+/// Способ сравнения определяется типом столбца, а не видом значений: значения столбцов из settings::numeric_columns
+/// сравниваются как числа, остальные - побайтово как текст, поэтому для текстового столбца '10' > '9' ложно, как в базе данных.
+/// '_' в LIKE соответствует одному символу UTF-8.
+/// Сравнение числа со строкой, регистр и символ экранирования LIKE различаются между базами данных и задаются settings.
+/// По умолчанию используется поведение PostgreSQL.
+class compiled_condition
+{
+public:
+    /// Настройки семантики сравнений.
+    struct settings
+    {
+        /// Символ экранирования LIKE. '\0' отключает экранирование, как LIKE без ESCAPE в SQLite.
+        char like_escape = '\\';
+
+        /// Учитывать регистр в LIKE. SQLite по умолчанию не учитывает регистр латинских букв.
+        bool case_sensitive_like = true;
+
+        /// Число всегда меньше строки, не являющейся числом, как при сравнении классов хранения SQLite.
+        /// Иначе такие значения сравниваются побайтово как строки. Действует только для столбцов из numeric_columns.
+        bool numbers_before_text = false;
+
+        /// Имена столбцов числового типа. Значения остальных столбцов сравниваются как текст.
+        std::vector<std::string> numeric_columns {};
+    };
+
+    /// Настройки, соответствующие SQLite: LIKE без ESCAPE и без учета регистра, числа меньше строк в числовых столбцах.
+    /// Столбцы с числовой affinity (INTEGER, REAL, NUMERIC) перечисляются в numeric_columns.
+    static settings sqlite_settings();
+
+public:
+    /// Тип, представляющий строку таблицы.
+    using row = std::vector<std::string>;
+
+    /// Функция, возвращающая значение столбца по его номеру в описании таблицы.
+    using value_accessor = std::function<const std::string&(size_t column_index)>;
+
+public:
+    /**
+     * Компилирует условие для строк указанной таблицы.
+     *
+     * @param condition Условие. Пустое условие подходит для любой строки.
+     * @param schema Описание таблицы, задающее порядок значений в строке.
+     * @throw std::invalid_argument Если условие ссылается на отсутствующий столбец,
+     * содержит вложенный запрос или пользовательский оператор.
+     */
+    compiled_condition(const condition_group& condition, const table& schema);
+
+    /**
+     * Компилирует условие для строк указанной таблицы с указанной семантикой сравнений.
+     *
+     * @param condition Условие. Пустое условие подходит для любой строки.
+     * @param schema Описание таблицы, задающее порядок значений в строке.
+     * @param settings Настройки семантики сравнений.
+     * @throw std::invalid_argument Если settings::numeric_columns содержит столбец, отсутствующий в таблице.
+     */
+    compiled_condition(const condition_group& condition, const table& schema, settings settings);
+
+    /**
+     * Проверяет строку в модели строк sql_table.
+     *
+     * @param row Значения столбцов в порядке описания таблицы.
+     * @return true, если условие истинно, иначе false.
+     */
+    bool matches(const row& row) const;
+
+    /**
+     * Проверяет строку, значения которой предоставляет пользовательская функция.
+     *
+     * @param accessor Функция доступа к значению столбца.
+     * @return true, если условие истинно, иначе false.
+     */
+    bool matches(const value_accessor& accessor) const;
+
+    /**
+     * Возвращает строки, для которых условие истинно.
+     *
+     * @param rows Строки для проверки.
+     * @return Подходящие строки в исходном порядке.
+     */
+    std::vector<row> filter(const std::vector<row>& rows) const;
+
+    /**
+     * Возвращает количество инструкций скомпилированного условия.
+     * @return Количество инструкций.
+     */
+    size_t size() const;
+
+private:
+    /// Признак отсутствующего номера.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    /// Результат трехзначной логики SQL.
+    enum class truth : uint8_t
+    {
+        false_,
+        true_,
+        unknown
+    };
+
+    /// Код инструкции.
+    enum class opcode : uint8_t
+    {
+        and_,
+        or_,
+        equals,
+        not_equals,
+        less,
+        less_or_equals,
+        more,
+        more_or_equals,
+        in,
+        not_in,
+        like,
+        is_null,
+        is_not_null
+    };
+
+    /// Значение, с которым сравнивается столбец.
+    struct operand
+    {
+        /// Строковое значение.
+        std::string text;
+
+        /// Числовое значение, если is_number.
+        double number = 0;
+
+        /// Является ли значение числом.
+        bool is_number = false;
+
+        /// Является ли значение NULL.
+        bool is_null = false;
+
+        /// Номер столбца, если значение является ссылкой на столбец.
+        size_t column = npos;
+    };
+
+    /// Инструкция. Для AND и OR левый операнд следует сразу за инструкцией, правый начинается с first_operand.
+    struct instruction
+    {
+        opcode code;
+
+        /// Номер проверяемого столбца.
+        size_t column = 0;
+
+        /// Первый операнд в _operands либо начало правого операнда для AND и OR.
+        size_t first_operand = 0;
+
+        /// Количество операндов.
+        size_t operand_count = 0;
+
+        /// Значения проверяемого столбца сравниваются как числа.
+        bool numeric = false;
+    };
+
+private:
+    /**
+     * Добавляет инструкции для узла дерева условий в порядке обхода "узел, левый, правый".
+     */
+    void compile(const condition_group& node, const table& schema);
+
+    /**
+     * Добавляет инструкцию для отдельного условия.
+     */
+    void compile_leaf(const condition_group::condition& leaf, const table& schema);
+
+    /**
+     * Вычисляет инструкцию с указанным номером.
+     * @param getter Функция доступа к значению столбца по номеру.
+     */
+    template<typename Getter>
+    truth evaluate(size_t index, const Getter& getter) const;
+
+    /**
+     * Сравнивает значение столбца с операндом.
+     * @param numeric Столбец числового типа.
+     * @return Отрицательное число, ноль или положительное число.
+     */
+    int compare(const std::string& value, const operand& operand_value, const std::string& operand_text, bool numeric) const;
+
+    /**
+     * Проверяет значение на соответствие шаблону LIKE.
+     */
+    bool like(const std::string& value, const std::string& pattern) const;
+
+    /**
+     * Разбирает операнд и определяет, является ли он числом или NULL.
+     */
+    static operand make_operand(std::string text);
+
+private:
+    /// Инструкции в порядке обхода дерева.
+    std::vector<instruction> _instructions;
+
+    /// Операнды инструкций.
+    std::vector<operand> _operands;
+
+    /// Количество столбцов в строке.
+    size_t _column_count = 0;
+
+    /// Признаки числовых столбцов по номеру столбца.
+    std::vector<bool> _numeric_columns;
+
+    settings _settings {};
+};
+
+} // namespace query_craft
\ No newline at end of file
@@ -2,6 +2,8 @@
 
 #include "enum/conditionviewtype.h"
 #include "enum/logicaloperator.h"
+#include "memory/memoryresource.h"
+#include "memory/smallvector.h"
 #include "operator/equalsoperator.h"
 #include "operator/inoperator.h"
 #include "operator/lessoperator.h"
@@ -10,12 +12,15 @@
 #include "operator/moreorequalsoperator.h"
 #include "operator/notequalsoperator.h"
 #include "operator/notinoperator.h"
+#include "subquery.h"
 
 #include <TypeConverterApi/typeconverterapi.h>
 
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <memory>
+#include <string>
 #include <tuple>
 #include <vector>
 
@@ -28,6 +33,11 @@ struct condition_group
     /// Cтруктура представляющая отдельное условие.
     struct condition
     {
+        /// Список значений условия. Одно значение хранится внутри условия без выделения памяти в куче,
+        /// список из нескольких значений размещается в куче одним блоком.
+        /// Преобразуется в std::vector<std::string> копированием значений.
+        using value_list = memory::small_vector<std::string, 1>;
+
         /// Определяет структуру для хранения информации о столбце таблицы.
         struct column
         {
@@ -85,13 +95,13 @@ struct condition_group
              * Возвращает имя столбца.
              * @return Имя столбца.
              */
-            std::string name() const;
+            const std::string& name() const;
 
             /**
              * Возвращает полное имя столбца.
              * @return Полное имя столбца.
              */
-            std::string full_name() const;
+            const std::string& full_name() const;
 
             /**
              * Устанавливает полное имя столбца.
@@ -103,7 +113,7 @@ struct condition_group
              * Возвращает псевдоним столбца.
              * @return Псевдоним столбца.
              */
-            std::string alias() const;
+            const std::string& alias() const;
 
             /**
              * Устанавливает псевдоним столбца.
@@ -111,6 +121,13 @@ struct condition_group
              */
             void set_alias(const std::string& alias);
 
+            /**
+             * Устанавливает полное имя и псевдоним столбца, создавая один новый набор имен вместо двух.
+             * @param fullName Полное имя столбца.
+             * @param alias Псевдоним столбца.
+             */
+            void set_names(const std::string& fullName, const std::string& alias);
+
             /**
              * Добавляет настройку к столбцу.
              * @param settings Настройка, которую нужно добавить.
@@ -151,12 +168,13 @@ struct condition_group
             template<typename... Args>
             condition in(Args&&... args) const
             {
-                std::vector<std::string> values;
+                value_list values;
+                values.reserve(sizeof...(Args));
                 for(const auto& arg : { std::forward<Args>(args)... }) {
                     values.emplace_back(type_converter_api::type_converter<decltype(arg)>().convert_to_string(arg));
                 }
 
-                return create_condition(std::make_shared<operators::in_operator>(), std::move(values));
+                return create_condition(operators::shared_instance<operators::in_operator>(), std::move(values));
             }
 
             /**
@@ -170,15 +188,29 @@ struct condition_group
             template<class StartIt, class EndIt>
             condition in_list(StartIt&& start_it, EndIt&& end_it) const
             {
-                std::vector<std::string> values;
+                value_list values;
 
                 std::for_each(start_it, end_it, [&values](const auto& arg) {
                     values.emplace_back(type_converter_api::type_converter<decltype(arg)>().convert_to_string(arg));
                 });
 
-                return create_condition(std::make_shared<operators::in_operator>(), std::move(values));
+                return create_condition(operators::shared_instance<operators::in_operator>(), std::move(values));
             }
 
+            /**
+             * Возвращает условие, проверяющее, принадлежит ли значение столбца к результату вложенного запроса.
+             * @param query Вложенный запрос, возвращающий один столбец.
+             * @return Условие вида "column IN (SELECT ...)".
+             */
+            condition in(sub_query query) const;
+
+            /**
+             * Возвращает условие, проверяющее, не принадлежит ли значение столбца к результату вложенного запроса.
+             * @param query Вложенный запрос, возвращающий один столбец.
+             * @return Условие вида "column NOT IN (SELECT ...)".
+             */
+            condition not_in(sub_query query) const;
+
             /**
              * Возвращает условие, проверяющее, не принадлежит ли значение столбца к указанным значениям.
              * @tparam Args Типы аргументов, которые могут быть преобразованы в строки.
@@ -188,11 +220,12 @@ struct condition_group
             template<typename... Args>
             condition notIn(Args&&... args) const
             {
-                std::vector<std::string> values;
+                value_list values;
+                values.reserve(sizeof...(Args));
                 for(const auto& arg : { std::forward<Args>(args)... })
                     values.emplace_back(type_converter_api::type_converter<decltype(arg)>().convert_to_string(arg));
 
-                return create_condition(std::make_shared<operators::not_in_operator>(), std::move(values));
+                return create_condition(operators::shared_instance<operators::not_in_operator>(), std::move(values));
             }
 
             /**
@@ -206,13 +239,13 @@ struct condition_group
             template<class StartIt, class EndIt>
             condition not_in_list(StartIt&& start_it, EndIt&& end_it) const
             {
-                std::vector<std::string> values;
+                value_list values;
 
                 std::for_each(start_it, end_it, [&values](const auto& arg) {
                     values.emplace_back(type_converter_api::type_converter<decltype(arg)>().convert_to_string(arg));
                 });
 
-                return create_condition(std::make_shared<operators::not_in_operator>(), std::move(values));
+                return create_condition(operators::shared_instance<operators::not_in_operator>(), std::move(values));
             }
 
             /**
@@ -224,7 +257,7 @@ struct condition_group
             template<typename T>
             condition operator==(const T& value) const
             {
-                return create_condition(std::make_shared<operators::equals_operator>(),
+                return create_condition(operators::shared_instance<operators::equals_operator>(),
                     { type_converter_api::type_converter<T>().convert_to_string(value) });
             }
 
@@ -244,7 +277,7 @@ struct condition_group
             template<typename T>
             condition operator!=(const T& value) const
             {
-                return create_condition(std::make_shared<operators::not_equals_operator>(),
+                return create_condition(operators::shared_instance<operators::not_equals_operator>(),
                     { type_converter_api::type_converter<T>().convert_to_string(value) });
             }
 
@@ -264,7 +297,7 @@ struct condition_group
             template<typename T>
             condition operator<(const T& value) const
             {
-                return create_condition(std::make_shared<operators::less_operator>(),
+                return create_condition(operators::shared_instance<operators::less_operator>(),
                     { type_converter_api::type_converter<T>().convert_to_string(value) });
             }
 
@@ -284,7 +317,7 @@ struct condition_group
             template<typename T>
             condition operator<=(const T& value) const
             {
-                return create_condition(std::make_shared<operators::less_or_equals_operator>(),
+                return create_condition(operators::shared_instance<operators::less_or_equals_operator>(),
                     { type_converter_api::type_converter<T>().convert_to_string(value) });
             }
 
@@ -304,7 +337,7 @@ struct condition_group
             template<typename T>
             condition operator>(const T& value) const
             {
-                return create_condition(std::make_shared<operators::more_operator>(),
+                return create_condition(operators::shared_instance<operators::more_operator>(),
                     { type_converter_api::type_converter<T>().convert_to_string(value) });
             }
 
@@ -324,7 +357,7 @@ struct condition_group
             template<typename T>
             condition operator>=(const T& value) const
             {
-                return create_condition(std::make_shared<operators::more_or_equals_operator>(),
+                return create_condition(operators::shared_instance<operators::more_or_equals_operator>(),
                     { type_converter_api::type_converter<T>().convert_to_string(value) });
             }
 
@@ -341,6 +374,16 @@ struct condition_group
              */
             bool is_valid() const;
 
+            /// Неизменяемый набор имен столбца. Разделяется всеми копиями столбца и освобождается вместе с последней копией.
+            struct symbol;
+
+            /**
+             * Возвращает идентификатор набора имен. Копии столбца возвращают один и тот же идентификатор,
+             * поэтому его можно использовать как ключ при поиске уже встречавшихся столбцов.
+             * @return Адрес набора имен либо nullptr для столбца без имен.
+             */
+            const void* names_id() const;
+
         private:
             /**
              * Создает и возвращает условие, основанное на указанном операторе и значениях.
@@ -349,18 +392,13 @@ struct condition_group
              * @return Объект условия.
              */
             condition create_condition(std::shared_ptr<operators::IOperator>&& conditionOperator,
-                std::vector<std::string>&& values,
+                value_list&& values,
                 bool need_forging = true) const;
 
         private:
-            /// Имя столбца.
-            std::string _name {};
-
-            /// Полное имя столбца.
-            std::string _fullName {};
-
-            /// Псевдоним столбца.
-            std::string _alias {};
+            /// Имена столбца. Копирование столбца не копирует строки, а сравнение копий сводится к сравнению указателей.
+            /// Пустой указатель соответствует пустым именам.
+            std::shared_ptr<const symbol> _symbol {};
 
             /// Настройки столбца.
             settings _columnSettings = settings::none;
@@ -401,23 +439,99 @@ struct condition_group
          */
         std::string unwrap(condion_view_type view_type = condion_view_type::name) const;
 
+        /**
+         * Добавляет строковое представление текущего условия в конец буфера.
+         * @param out Буфер, в который добавляется условие.
+         * @param view_type Настройки для отображения названия колонки.
+         */
+        void unwrap(std::string& out, condion_view_type view_type = condion_view_type::name) const;
+
+        /**
+         * Возвращает точный размер строкового представления текущего условия.
+         * @param view_type Настройки для отображения названия колонки.
+         * @return Размер в байтах.
+         */
+        size_t estimate_size(condion_view_type view_type = condion_view_type::name) const;
+
+        /**
+         * Возвращает условие, проверяющее, что вложенный запрос возвращает хотя бы одну строку.
+         * @param query Вложенный запрос. Может ссылаться на столбцы внешнего запроса через full_name.
+         * @return Условие вида "EXISTS (SELECT ...)".
+         */
+        static condition exists(const sub_query& query);
+
+        /**
+         * Возвращает условие, проверяющее, что вложенный запрос не возвращает ни одной строки.
+         * @param query Вложенный запрос. Может ссылаться на столбцы внешнего запроса через full_name.
+         * @return Условие вида "NOT EXISTS (SELECT ...)".
+         */
+        static condition not_exists(const sub_query& query);
+
+        /**
+         * Создает условие из отдельных частей. Используется при восстановлении условий, например, из двоичного представления.
+         * @param condition_operator Оператор условия.
+         * @param condition_column Столбец условия. Может быть пустым для EXISTS и NOT EXISTS.
+         * @param values Значения условия.
+         * @param need_forging Являются ли значения литералами, которые нужно заключать в кавычки.
+         * @return Условие.
+         */
+        static condition create(std::shared_ptr<operators::IOperator> condition_operator,
+            column condition_column,
+            value_list values,
+            bool need_forging = true);
+
+        /**
+         * Возвращает условие вхождения набора столбцов в список кортежей.
+         * @param columns Столбцы составного ключа.
+         * @param tuples Кортежи, уже преобразованные в SQL вида "('1', '2')".
+         * @return Условие вида "(a, b) IN (('1', '2'), ...)".
+         * @note Для формирования кортежей из значений используйте row_in_list.
+         */
+        static condition row_in(std::vector<column> columns, value_list tuples);
+
         /**
          * Возвращает информацию о столбце текущего условия.
          * @return Объект ColumnInfo, содержащий информацию о столбце.
          */
-        column condition_column() const;
+        const column& condition_column() const;
 
         /**
          * Возвращает указатель на интерфейс оператора условия текущего условия.
          * @return Указатель на интерфейс оператора условия.
          */
-        std::shared_ptr<operators::IOperator> condition_operator() const;
+        const std::shared_ptr<operators::IOperator>& condition_operator() const;
 
         /**
          * Возвращает значения текущего условия.
          * @return Вектор строк, содержащий значения текущего условия.
          */
-        std::vector<std::string> values() const;
+        const value_list& values() const;
+
+        /**
+         * Проверяет, являются ли значения условия литералами.
+         * @return true, если значения экранируются при генерации, false если это ссылки на столбцы или вложенные запросы.
+         */
+        bool need_forging() const;
+
+        /**
+         * Возвращает столбцы составного ключа условия вида "(a, b) IN (...)".
+         * @return Столбцы либо пустой вектор для условий по одному столбцу.
+         */
+        const std::vector<column>& row_columns() const;
+
+        /**
+         * Возвращает копию условия с другим столбцом. Оператор и значения сохраняются.
+         * @param column Новый столбец условия.
+         * @return Новое условие.
+         */
+        condition with_column(const column& column) const;
+
+        /**
+         * Возвращает копию условия с другими значениями. Оператор, столбец и способ экранирования сохраняются.
+         * @param values Новые значения условия.
+         * @return Новое условие.
+         */
+        condition with_values(value_list values) const;
 
         /**
          * Проверяет, является ли текущее условие валидным.
@@ -425,10 +539,42 @@ struct condition_group
          */
         bool is_valid() const;
 
+    private:
+        /**
+         * Добавляет название столбца условия в конец буфера.
+         * @param out Буфер.
+         * @param view_type Настройки для отображения названия колонки.
+         */
+        void unwrap_column(std::string& out, condion_view_type view_type) const;
+
+        /**
+         * Возвращает размер названия столбца условия.
+         * @param view_type Настройки для отображения названия колонки.
+         * @return Размер в байтах.
+         */
+        size_t column_size(condion_view_type view_type) const;
+
+        /**
+         * Добавляет название столбца в конец буфера.
+         * @param out Буфер.
+         * @param column Столбец.
+         * @param view_type Настройки для отображения названия колонки.
+         */
+        static void append_column(std::string& out, const column& column, condion_view_type view_type);
+
+        /**
+         * Возвращает размер названия столбца.
+         * @param column Столбец.
+         * @param view_type Настройки для отображения названия колонки.
+         * @return Размер в байтах.
+         */
+        static size_t column_name_size(const column& column, condion_view_type view_type);
+
     private:
         std::shared_ptr<operators::IOperator> _condition_operator {};
         column _column {};
-        std::vector<std::string> _values {};
+        std::vector<column> _row_columns {};
+        value_list _values {};
         bool _need_forging = true;
     };
 
@@ -484,13 +630,80 @@ struct condition_group
      */
     std::string unwrap(condion_view_type view_type = condion_view_type::name, bool compressed = true) const;
 
+    /**
+     * Добавляет строковое представление текущего условия в конец буфера.
+     * @param out Буфер, в который добавляется условие.
+     * @param view_type Настройки для отображения названия колонки.
+     * @param compressed Сжать выходную строку, если это возможно.
+     * @note Если емкости буфера достаточно, память не выделяется.
+     */
+    void unwrap(std::string& out, condion_view_type view_type = condion_view_type::name, bool compressed = true) const;
+
+    /**
+     * Возвращает точный размер строкового представления текущего условия.
+     * @param view_type Настройки для отображения названия колонки.
+     * @param compressed Сжать выходную строку, если это возможно.
+     * @return Размер в байтах.
+     */
+    size_t estimate_size(condion_view_type view_type = condion_view_type::name, bool compressed = true) const;
+
     /**
      * Проверяет, является ли текущее условие валидным.
      * @return true, если было создано условие, иначе false.
      */
     bool is_valid() const;
 
+    /**
+     * Проверяет, является ли текущее условие листом (отдельным условием без дочерних групп).
+     * @return true, если текущее условие является листом, иначе false.
+     */
+    bool is_leaf() const;
+
+    /**
+     * Возвращает отдельное условие листа.
+     * @return Условие. Для внутренних узлов возвращается пустое условие.
+     */
+    const condition& leaf() const;
+
+    /**
+     * Возвращает логический оператор, объединяющий дочерние группы.
+     * @return Логический оператор внутреннего узла.
+     */
+    logical_operator group_operator() const;
+
+    /**
+     * Возвращает левую дочернюю группу.
+     * @return Указатель на группу либо nullptr для листа.
+     */
+    const condition_group* left() const;
+
+    /**
+     * Возвращает правую дочернюю группу.
+     * @return Указатель на группу либо nullptr для листа.
+     */
+    const condition_group* right() const;
+
+    /**
+     * Строит новое дерево условий, заменяя каждый лист результатом функции.
+     * Логические операторы и структура внутренних узлов сохраняются.
+     * @param leaf_transform Функция, возвращающая замену для отдельного условия.
+     * @return Новое дерево условий.
+     */
+    condition_group transform(const std::function<condition_group(const condition&)>& leaf_transform) const;
+
 private:
+    friend class condition_interner;
+
+    /// Запомненные строковые представления узла для каждого вида отображения колонок.
+    /// Создается только для узлов, полученных через condition_interner, и разделяется всеми копиями узла.
+    struct fragment_cache;
+
+    /**
+     * Создает пустой кэш строковых представлений узла.
+     * @return Указатель на кэш.
+     */
+    static std::shared_ptr<fragment_cache> make_fragment_cache();
+
     /**
      * Проверяет, является ли текущее условие листом (не содержит дочерних условий).
      * @return true, если текущее условие является листом, иначе false.
@@ -500,11 +713,42 @@ private:
     /**
      * Рекурсивно обходит дерево условий и создает строковое представление.
      * @param node Указатель на текущее условие.
-     * @param stream Строковый поток, куда будут добавляться условия.
+     * @param out Буфер, куда будут добавляться условия.
+     * @param view_type Настройки для отображения названия колонки.
+     * @param compressed Сжать выходную строку.
+     */
+    static void unwrap_tree(const condition_group* node, std::string& out, condion_view_type view_type, bool compressed);
+
+    /**
+     * Создает строковое представление узла без использования запомненного представления самого узла.
+     * @param node Указатель на текущее условие.
+     * @param out Буфер, куда будут добавляться условия.
      * @param view_type Настройки для отображения названия колонки.
      * @param compressed Сжать выходную строку.
      */
-    static void unwrap_tree(const condition_group* node, std::stringstream& stream, condion_view_type view_type, bool compressed);
+    static void render_node(const condition_group* node, std::string& out, condion_view_type view_type, bool compressed);
+
+    /**
+     * Рекурсивно обходит дерево условий и вычисляет размер строкового представления.
+     * @param node Указатель на текущее условие.
+     * @param view_type Настройки для отображения названия колонки.
+     * @param compressed Сжать выходную строку.
+     * @return Размер в байтах.
+     */
+    static size_t tree_size(const condition_group* node, condion_view_type view_type, bool compressed);
+
+    /**
+     * Создает узел дерева условий.
+     * Память под узел выделяется из memory::get_default_resource(), что позволяет строить дерево на арене запроса.
+     * @param args Аргументы конструктора condition_group.
+     * @return Указатель на созданный узел.
+     * @note Узлы, созданные на арене, не должны переживать освобождение арены.
+     */
+    template<typename... Args>
+    static std::shared_ptr<condition_group> make_node(Args&&... args)
+    {
+        return std::allocate_shared<condition_group>(memory::polymorphic_allocator<condition_group>(), std::forward<Args>(args)...);
+    }
 
 private:
     /**
@@ -524,6 +768,12 @@ private:
      * Используется для представления сложных условий с использованием логических операторов.
      */
     std::shared_ptr<condition_group> _right {};
+
+    /**
+     * Запомненные строковые представления узла.
+     * Пусто для узлов, созданных без condition_interner.
+     */
+    std::shared_ptr<fragment_cache> _fragments {};
 };
 
 using column_info = condition_group::condition::column;
@@ -541,6 +791,20 @@ using column_settings = condition_group::condition::column::settings;
  */
 column_settings operator|(column_settings a, column_settings b);
 
+/**
+ * Возвращает условие, проверяющее, что вложенный запрос возвращает хотя бы одну строку.
+ * @param query Вложенный запрос.
+ * @return Условие вида "EXISTS (SELECT ...)".
+ */
+condition_info exists(const sub_query& query);
+
+/**
+ * Возвращает условие, проверяющее, что вложенный запрос не возвращает ни одной строки.
+ * @param query Вложенный запрос.
+ * @return Условие вида "NOT EXISTS (SELECT ...)".
+ */
+condition_info not_exists(const sub_query& query);
+
 column_settings primary_key();
 
 column_settings not_null();
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "conditiongroup.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace query_craft {
+
+/// Класс, объединяющий одинаковые поддеревья условий в один общий неизменяемый узел.
+/// Одинаковые условия, полученные через один экземпляр, сравниваются по указателю,
+/// а строковое представление каждого узла создается один раз и затем переиспользуется.
+/// Узлы хранятся до вызова clear() или уничтожения объекта. Методы можно вызывать из разных потоков.
+/// Узлы всегда выделяются в глобальной куче, поэтому условие, построенное на арене запроса, можно сохранить через intern.
+class condition_interner
+{
+public:
+    /// Общий неизменяемый узел дерева условий.
+    using interned = std::shared_ptr<const condition_group>;
+
+public:
+    condition_interner() = default;
+
+    condition_interner(const condition_interner& other) = delete;
+
+    condition_interner& operator=(const condition_interner& other) = delete;
+
+    /**
+     * Возвращает общий узел, равный условию.
+     * Поддеревья условия также заменяются общими узлами.
+     *
+     * @param condition Условие.
+     * @return Общий узел. Для одинаковых условий возвращается один и тот же указатель.
+     */
+    interned intern(const condition_group& condition);
+
+    /**
+     * Возвращает общий узел, объединяющий два общих узла через AND.
+     *
+     * @param lhs Левое условие, полученное из этого же объекта.
+     * @param rhs Правое условие, полученное из этого же объекта.
+     * @return Общий узел.
+     */
+    interned and_(const interned& lhs, const interned& rhs);
+
+    /**
+     * Возвращает общий узел, объединяющий два общих узла через OR.
+     *
+     * @param lhs Левое условие, полученное из этого же объекта.
+     * @param rhs Правое условие, полученное из этого же объекта.
+     * @return Общий узел.
+     */
+    interned or_(const interned& lhs, const interned& rhs);
+
+    /**
+     * Возвращает количество различных узлов.
+     */
+    size_t size() const;
+
+    /**
+     * Освобождает все узлы, на которые не осталось внешних ссылок.
+     * Ранее полученные узлы остаются корректными, но больше не совпадают по указателю с новыми.
+     */
+    void clear();
+
+private:
+    /**
+     * Рекурсивно заменяет узел и его поддеревья общими узлами. Вызывается под блокировкой.
+     */
+    std::shared_ptr<condition_group> intern_node(const condition_group& node);
+
+    /**
+     * Возвращает общий внутренний узел с указанными общими дочерними узлами. Вызывается под блокировкой.
+     */
+    std::shared_ptr<condition_group> intern_group(logical_operator group_operator,
+        const std::shared_ptr<condition_group>& left,
+        const std::shared_ptr<condition_group>& right);
+
+    /**
+     * Возвращает общий узел для ключа или добавляет новый. Вызывается под блокировкой.
+     */
+    std::shared_ptr<condition_group> find_or_insert(std::string&& key, condition_group&& node);
+
+    /**
+     * Возвращает изменяемый указатель на общий узел. Узел, созданный не интернером, предварительно заменяется общим.
+     * @throw std::invalid_argument Если указатель пустой.
+     */
+    std::shared_ptr<condition_group> own(const interned& node);
+
+    /**
+     * Создает ключ отдельного условия из оператора, столбцов и значений.
+     */
+    static void append_leaf_key(std::string& key, const condition_group::condition& leaf);
+
+private:
+    mutable std::mutex _mutex;
+
+    /// Общие узлы по структурному ключу. Ключ внутреннего узла содержит адреса общих дочерних узлов.
+    std::unordered_map<std::string, std::shared_ptr<condition_group>> _nodes;
+};
+
+} // namespace query_craft
\ No newline at end of file
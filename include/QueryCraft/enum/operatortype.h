@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+
+namespace query_craft {
+
+/**
+ * @brief Перечисление типов операторов сравнения.
+ * Позволяет анализировать дерево условий без сравнения SQL-представлений операторов.
+ */
+enum class operator_type : uint8_t
+{
+    /**
+     * Пользовательский оператор, тип которого неизвестен.
+     */
+    custom,
+
+    /**
+     * Оператор "=".
+     */
+    equals,
+
+    /**
+     * Оператор "!=".
+     */
+    not_equals,
+
+    /**
+     * Оператор "<".
+     */
+    less,
+
+    /**
+     * Оператор "<=".
+     */
+    less_or_equals,
+
+    /**
+     * Оператор ">".
+     */
+    more,
+
+    /**
+     * Оператор ">=".
+     */
+    more_or_equals,
+
+    /**
+     * Оператор "IN".
+     */
+    in,
+
+    /**
+     * Оператор "NOT IN".
+     */
+    not_in,
+
+    /**
+     * Оператор "LIKE".
+     */
+    like,
+
+    /**
+     * Оператор "IS".
+     */
+    is,
+
+    /**
+     * Оператор "IS NOT".
+     */
+    is_not,
+
+    /**
+     * Оператор "EXISTS".
+     */
+    exists,
+
+    /**
+     * Оператор "NOT EXISTS".
+     */
+    not_exists
+};
+
+} // namespace query_craft
\ No newline at end of file
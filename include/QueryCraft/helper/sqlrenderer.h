@@ -0,0 +1,325 @@
+#pragma once
+
+#include "../arrayview.h"
+#include "../joincolumn.h"
+#include "../sortcolumn.h"
+#include "../table.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace query_craft {
+namespace helper {
+
+/// Строка таблицы в виде вектора значений столбцов.
+using row = std::vector<std::string>;
+
+/**
+ * Добавляет значение в кавычках с экранированием спецсимволов.
+ *
+ * @param out Буфер, в который добавляется значение.
+ * @param value Значение. Значение NULL добавляется без кавычек.
+ */
+void append_escaped_value(std::string& out, const std::string& value);
+
+/**
+ * Возвращает размер значения после экранирования.
+ *
+ * @param value Значение.
+ * @return Размер в байтах.
+ */
+size_t escaped_value_size(const std::string& value);
+
+/**
+ * Добавляет целое число в десятичной записи без выделения памяти.
+ *
+ * @param out Буфер, в который добавляется число.
+ * @param value Число.
+ */
+void append_number(std::string& out, size_t value);
+
+/**
+ * Возвращает количество цифр в десятичной записи числа.
+ *
+ * @param value Число.
+ * @return Количество цифр.
+ */
+size_t number_size(size_t value);
+
+/**
+ * Добавляет список столбцов для выборки ("full_name AS alias, ..." либо "*").
+ *
+ * @param out Буфер.
+ * @param columns Столбцы для выборки.
+ */
+void append_select_list(std::string& out, array_view<column_info> columns);
+
+/**
+ * Возвращает размер списка столбцов для выборки.
+ *
+ * @param columns Столбцы для выборки.
+ * @return Размер в байтах.
+ */
+size_t select_list_size(array_view<column_info> columns);
+
+/**
+ * Добавляет соединения таблиц (" LEFT JOIN ... ON ...").
+ *
+ * @param out Буфер.
+ * @param join_columns Информация о join соединениях.
+ */
+void append_joins(std::string& out, array_view<join_column> join_columns);
+
+/**
+ * Возвращает размер соединений таблиц.
+ *
+ * @param join_columns Информация о join соединениях.
+ * @return Размер в байтах.
+ */
+size_t joins_size(array_view<join_column> join_columns);
+
+/**
+ * Добавляет условие (" WHERE ..."), если оно валидно.
+ *
+ * @param out Буфер.
+ * @param condition Условие.
+ * @param view_type Настройки для отображения названия колонки.
+ */
+void append_where(std::string& out, const condition_group& condition, condion_view_type view_type);
+
+/**
+ * Возвращает размер условия вместе с ключевым словом WHERE.
+ *
+ * @param condition Условие.
+ * @param view_type Настройки для отображения названия колонки.
+ * @return Размер в байтах.
+ */
+size_t where_size(const condition_group& condition, condion_view_type view_type);
+
+/**
+ * Добавляет сортировку (" ORDER BY ..."), если она задана.
+ *
+ * @param out Буфер.
+ * @param sort_columns Информация о колонках необходимых для сортировок.
+ */
+void append_order_by(std::string& out, array_view<sort_column> sort_columns);
+
+/**
+ * Возвращает размер сортировки.
+ *
+ * @param sort_columns Информация о колонках необходимых для сортировок.
+ * @return Размер в байтах.
+ */
+size_t order_by_size(array_view<sort_column> sort_columns);
+
+/**
+ * Добавляет ограничения выборки (" LIMIT n OFFSET m"). Нулевые значения пропускаются.
+ *
+ * @param out Буфер.
+ * @param limit Лимит выборки.
+ * @param offset Смещение выборки.
+ */
+void append_limit_offset(std::string& out, size_t limit, size_t offset);
+
+/**
+ * Возвращает размер ограничений выборки.
+ *
+ * @param limit Лимит выборки.
+ * @param offset Смещение выборки.
+ * @return Размер в байтах.
+ */
+size_t limit_offset_size(size_t limit, size_t offset);
+
+/**
+ * Генерация SQL-запроса для вставки строк в таблицу.
+ *
+ * @param out Буфер, в конец которого добавляется запрос.
+ * @param schema Описание таблицы.
+ * @param rows Строки для вставки.
+ * @param columns Столбцы для вставки. Если пусто, используются все столбцы таблицы.
+ * @param need_returning Флаг означающий что в конце запроса необходимо вернуть вставленные колонки
+ * @param returning_columns Колонки которые необходимо вернуть после вставки
+ * @note Не изменяет ни описание таблицы, ни строки, поэтому безопасна для вызова из нескольких потоков.
+ */
+void insert_sql(std::string& out,
+    const table& schema,
+    const std::vector<row>& rows,
+    array_view<column_info> columns,
+    bool need_returning,
+    array_view<column_info> returning_columns);
+
+/**
+ * Генерация SQL-запроса для вставки строк в таблицу.
+ *
+ * @param schema Описание таблицы.
+ * @param rows Строки для вставки.
+ * @param columns Столбцы для вставки. Если пусто, используются все столбцы таблицы.
+ * @param need_returning Флаг означающий что в конце запроса необходимо вернуть вставленные колонки
+ * @param returning_columns Колонки которые необходимо вернуть после вставки
+ * @return SQL-запрос для вставки.
+ */
+std::string insert_sql(const table& schema,
+    const std::vector<row>& rows,
+    array_view<column_info> columns,
+    bool need_returning,
+    array_view<column_info> returning_columns);
+
+/**
+ * Возвращает точный размер SQL-запроса для вставки строк.
+ *
+ * @param schema Описание таблицы.
+ * @param rows Строки для вставки.
+ * @param columns Столбцы для вставки. Если пусто, используются все столбцы таблицы.
+ * @param need_returning Флаг означающий что в конце запроса необходимо вернуть вставленные колонки
+ * @param returning_columns Колонки которые необходимо вернуть после вставки
+ * @return Размер в байтах.
+ */
+size_t insert_sql_size(const table& schema,
+    const std::vector<row>& rows,
+    array_view<column_info> columns,
+    bool need_returning,
+    array_view<column_info> returning_columns);
+
+/**
+ * Генерация SQL-запроса для обновления строки в таблице.
+ *
+ * @param out Буфер, в конец которого добавляется запрос.
+ * @param schema Описание таблицы.
+ * @param rows Строки для обновления. Должна быть ровно одна строка.
+ * @param condition Условие для выбора строки.
+ * @param columns Столбцы для обновления. Если пусто, используются все столбцы таблицы.
+ * @note Не изменяет ни описание таблицы, ни строки, поэтому безопасна для вызова из нескольких потоков.
+ */
+void update_sql(std::string& out,
+    const table& schema,
+    const std::vector<row>& rows,
+    const condition_group& condition,
+    array_view<column_info> columns);
+
+/**
+ * Генерация SQL-запроса для обновления строки в таблице.
+ *
+ * @param schema Описание таблицы.
+ * @param rows Строки для обновления. Должна быть ровно одна строка.
+ * @param condition Условие для выбора строки.
+ * @param columns Столбцы для обновления. Если пусто, используются все столбцы таблицы.
+ * @return SQL-запрос для обновления.
+ */
+std::string update_sql(const table& schema,
+    const std::vector<row>& rows,
+    const condition_group& condition,
+    array_view<column_info> columns);
+
+/**
+ * Возвращает точный размер SQL-запроса для обновления строки.
+ *
+ * @param schema Описание таблицы.
+ * @param rows Строки для обновления.
+ * @param condition Условие для выбора строки.
+ * @param columns Столбцы для обновления. Если пусто, используются все столбцы таблицы.
+ * @return Размер в байтах.
+ */
+size_t update_sql_size(const table& schema,
+    const std::vector<row>& rows,
+    const condition_group& condition,
+    array_view<column_info> columns);
+
+/**
+ * Возвращает маску столбцов, значения которых различаются в старой и новой строке.
+ *
+ * @param old_row Строка до изменения.
+ * @param new_row Строка после изменения.
+ * @return Маска измененных столбцов.
+ */
+std::vector<bool> changed_columns(const row& old_row, const row& new_row);
+
+/**
+ * Генерация SQL-запроса для обновления только отмеченных столбцов строки.
+ *
+ * @param out Буфер, в конец которого добавляется запрос.
+ * @param schema Описание таблицы.
+ * @param new_row Новые значения всех столбцов columns.
+ * @param changed Маска столбцов, которые нужно обновить.
+ * @param condition Условие для выбора строки.
+ * @param distinct_guard Добавить к условию проверку "column IS DISTINCT FROM value", чтобы не изменять строки, где значения уже совпадают.
+ * @param columns Столбцы строки. Если пусто, используются все столбцы таблицы.
+ * @return false, если ни один столбец не отмечен. В этом случае в буфер ничего не добавляется.
+ */
+bool masked_update_sql(std::string& out,
+    const table& schema,
+    const row& new_row,
+    const std::vector<bool>& changed,
+    const condition_group& condition,
+    bool distinct_guard,
+    array_view<column_info> columns);
+
+/**
+ * Генерация SQL-запросов для обновления набора строк, идентифицируемых ключевым столбцом.
+ * Обновляются только измененные столбцы каждой строки. Строки с одинаковыми изменениями
+ * объединяются в один запрос с условием "key IN (...)".
+ *
+ * @param schema Описание таблицы.
+ * @param changes Пары строк до и после изменения.
+ * @param key Ключевой столбец. Значение ключа берется из строки до изменения.
+ * @param distinct_guard Добавить к условию проверку "column IS DISTINCT FROM value".
+ * @param columns Столбцы строк. Если пусто, используются все столбцы таблицы. Должны содержать ключевой столбец.
+ * @return SQL-запросы. Строки без изменений пропускаются.
+ */
+std::vector<std::string> diff_update_sql(const table& schema,
+    const std::vector<std::pair<row, row>>& changes,
+    const column_info& key,
+    bool distinct_guard,
+    array_view<column_info> columns);
+
+/**
+ * Генерация SQL-запроса для вставки в таблицу результата выборки из другой таблицы.
+ * Строки копируются на сервере и не передаются клиенту.
+ *
+ * @param out Буфер, в конец которого добавляется запрос.
+ * @param target Таблица, в которую вставляются строки.
+ * @param target_columns Столбцы для вставки. Если пусто, используются все столбцы target.
+ * @param source Таблица, из которой выбираются строки.
+ * @param join_columns Информация о join соединениях.
+ * @param condition Условие для выбора строк.
+ * @param sort_columns Информация о колонках необходимых для сортировок.
+ * @param limit Лимит выборки.
+ * @param offset Смещение выборки.
+ * @param source_columns Столбцы для выборки. Если пусто, используются все столбцы source.
+ * @throw std::invalid_argument Если количество столбцов вставки и выборки различается.
+ */
+void insert_from_select_sql(std::string& out,
+    const table& target,
+    array_view<column_info> target_columns,
+    const table& source,
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    size_t limit,
+    size_t offset,
+    array_view<column_info> source_columns);
+
+/**
+ * Генерация SQL-запроса для переноса строк из одной таблицы в другую одним запросом
+ * "WITH moved AS (DELETE ... RETURNING ...) INSERT INTO ... SELECT ... FROM moved" (PostgreSQL).
+ *
+ * @param out Буфер, в конец которого добавляется запрос.
+ * @param source Таблица, из которой удаляются строки.
+ * @param target Таблица, в которую вставляются строки.
+ * @param condition Условие для выбора строк.
+ * @param source_columns Переносимые столбцы source. Если пусто, используются все столбцы source.
+ * @param target_columns Столбцы target. Если пусто, используются все столбцы target.
+ * @param batch_limit Максимальное количество переносимых строк. 0 - без ограничения.
+ * Ограничение выполняется через первичный ключ source: "WHERE key IN (SELECT key ... LIMIT n)".
+ * @throw std::invalid_argument Если количество столбцов различается либо для batch_limit у source нет единственного первичного ключа.
+ */
+void move_rows_sql(std::string& out,
+    const table& source,
+    const table& target,
+    const condition_group& condition,
+    array_view<column_info> source_columns,
+    array_view<column_info> target_columns,
+    size_t batch_limit);
+
+} // namespace helper
+} // namespace query_craft
\ No newline at end of file
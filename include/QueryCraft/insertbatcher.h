@@ -0,0 +1,209 @@
+#pragma once
+
+#include "rowbatch.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace query_craft {
+
+/// Класс, накапливающий строки от нескольких потоков и автоматически сбрасывающий их
+/// в виде многострочных запросов INSERT при достижении порогов по количеству строк, объему данных или времени.
+///
+/// Пачка, на которой приемник выбросил исключение, не теряется: она и все еще не отправленные строки возвращаются
+/// в очередь и отправляются повторно при следующем сбросе (по таймеру, порогу, flush() или stop()).
+/// Такие строки продолжают учитываться в pending_rows() и в ограничении settings::max_pending_rows,
+/// поэтому при недоступном приемнике производители блокируются, а не накапливают строки без предела.
+class insert_batcher
+{
+public:
+    /// Тип, представляющий строку таблицы.
+    using row = sql_table::row;
+
+    /**
+     * Функция-приемник сгенерированных запросов.
+     * Принимает SQL-запрос и строки, вошедшие в него.
+     * Вызовы приемника сериализованы, одновременно выполняется не более одного вызова.
+     * Если приемник выбрасывает исключение, пачка считается неотправленной и будет передана повторно,
+     * поэтому приемник не должен частично применять пачку (например, выполнять запрос вне транзакции по частям).
+     */
+    using sink = std::function<void(const std::string& sql, const std::vector<row>& rows)>;
+
+    /// Настройки сброса накопленных строк.
+    struct settings
+    {
+        /// Максимальное количество строк в одном запросе. При накоплении такого количества строк запускается сброс.
+        size_t max_rows = 1000;
+
+        /// Примерный объем данных в байтах, при накоплении которого запускается сброс.
+        size_t max_bytes = 1024 * 1024;
+
+        /// Максимальное время, которое строка может ожидать сброса.
+        std::chrono::milliseconds max_delay { 100 };
+
+        /// Количество ожидающих строк, при превышении которого производители блокируются,
+        /// пока приемник не обработает накопленные данные.
+        size_t max_pending_rows = 100000;
+
+        /// Количество шардов очереди. 0 означает количество аппаратных потоков.
+        size_t shard_count = 0;
+
+        /// Столбцы для вставки. По умолчанию все столбцы.
+        std::vector<column_info> columns {};
+    };
+
+public:
+    /**
+     * Конструктор, запускающий фоновый поток сброса.
+     *
+     * @param schema Разделяемое описание таблицы.
+     * @param sink Приемник сгенерированных запросов.
+     * @param settings Настройки сброса.
+     */
+    insert_batcher(shared_schema schema, sink sink, settings settings);
+
+    /**
+     * Конструктор с настройками по умолчанию.
+     *
+     * @param schema Разделяемое описание таблицы.
+     * @param sink Приемник сгенерированных запросов.
+     */
+    insert_batcher(shared_schema schema, sink sink);
+
+    insert_batcher(const insert_batcher& other) = delete;
+
+    insert_batcher& operator=(const insert_batcher& other) = delete;
+
+    /**
+     * Останавливает фоновый поток и сбрасывает оставшиеся строки.
+     */
+    ~insert_batcher();
+
+    /**
+     * Добавление строки. Может вызываться одновременно из нескольких потоков.
+     *
+     * @param row Строка для добавления.
+     * @note Блокирует вызывающий поток, если количество ожидающих строк превышает settings::max_pending_rows.
+     * @note Пробрасывает исключение, возникшее в приемнике при предыдущем сбросе.
+     */
+    void add_row(row row);
+
+    /**
+     * Добавление строки с использованием переменного числа аргументов.
+     *
+     * @param args Значения для добавления в качестве столбцов.
+     */
+    template<typename... Args>
+    void add_row_args(Args&&... args)
+    {
+        add_row(sql_table::make_row(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Синхронно сбрасывает все строки, добавленные до вызова, включая строки, не принятые приемником ранее.
+     * @note Пробрасывает исключение, возникшее в приемнике. Неотправленные строки остаются в очереди,
+     * и вызов можно повторить.
+     */
+    void flush();
+
+    /**
+     * Останавливает фоновый поток, предварительно сбросив все оставшиеся строки.
+     * После остановки добавление строк запрещено.
+     * @note Если приемник выбросил исключение, оно пробрасывается, а неотправленные строки остаются в очереди:
+     * их можно отправить повторными вызовами flush(). Строки, оставшиеся в очереди при уничтожении объекта, теряются,
+     * их количество можно проверить через pending_rows().
+     */
+    void stop();
+
+    /**
+     * Возвращает количество строк, ожидающих сброса.
+     * @return Количество строк.
+     */
+    size_t pending_rows() const;
+
+private:
+    /// Шард очереди. Производители распределяются по шардам, чтобы не конкурировать за одну блокировку.
+    struct shard
+    {
+        std::mutex mutex;
+        std::vector<row> rows;
+    };
+
+    /**
+     * Цикл фонового потока сброса.
+     */
+    void run();
+
+    /**
+     * Резервирует место для строки в ограничении settings::max_pending_rows.
+     * Ожидает освобождения места, если ограничение достигнуто.
+     *
+     * @param rows_before Количество ожидающих строк до резервирования.
+     * @throw std::logic_error Если объект остановлен.
+     */
+    void reserve_row(size_t& rows_before);
+
+    /**
+     * Забирает неотправленные строки и строки из всех шардов и передает их приемнику пачками не более settings::max_rows.
+     * При ошибке приемника пачка и оставшиеся строки возвращаются в очередь неотправленных строк.
+     * @return false, если приемник выбросил исключение.
+     */
+    bool drain();
+
+    /**
+     * Пробрасывает исключение приемника, если оно было.
+     */
+    void rethrow_sink_error();
+
+    /**
+     * Возвращает шард для текущего потока.
+     * @return Ссылка на шард.
+     */
+    shard& current_shard();
+
+    /**
+     * Возвращает примерный объем строки в итоговом запросе.
+     * @param row Строка.
+     * @return Объем в байтах.
+     */
+    static size_t row_bytes(const row& row);
+
+private:
+    shared_schema _schema;
+    sink _sink;
+    settings _settings;
+
+    std::unique_ptr<shard[]> _shards;
+
+    std::atomic<size_t> _pending_rows { 0 };
+    std::atomic<size_t> _pending_bytes { 0 };
+
+    /// Количество производителей, находящихся внутри add_row. Нужно, чтобы stop() не потерял строки.
+    std::atomic<size_t> _active_producers { 0 };
+
+    /// Сериализует вызовы приемника.
+    std::mutex _sink_mutex;
+
+    /// Строки, не принятые приемником. Отправляются первыми при следующем сбросе. Защищены _sink_mutex.
+    std::vector<row> _failed_rows;
+
+    std::mutex _error_mutex;
+    std::exception_ptr _sink_error {};
+    std::atomic<bool> _has_sink_error { false };
+
+    std::mutex _state_mutex;
+    std::condition_variable _flush_cv;
+    std::condition_variable _space_cv;
+    std::atomic<bool> _stopping { false };
+    bool _flush_requested = false;
+
+    std::thread _worker;
+};
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "conditiongroup.h"
+
+#include <functional>
+#include <string>
+
+namespace query_craft {
+
+/// Функция, вызываемая для условия LIKE, которое не может использовать индекс (шаблон начинается с '%' или '_').
+using like_diagnostics_hook = std::function<void(const condition_info& condition)>;
+
+/**
+ * Заменяет условия LIKE с постоянным префиксом на диапазон, который может использовать B-tree индекс.
+ *
+ * Замена выполняется только по явному вызову и допустима только для столбцов с побайтовым сравнением строк
+ * (COLLATE "C" в PostgreSQL, BINARY в SQLite) и LIKE с учетом регистра. При лингвистических правилах сортировки
+ * (en_US и т.п.) и при LIKE без учета регистра (по умолчанию в SQLite) диапазон отбрасывает подходящие строки:
+ * например, для 'jaz%' верхняя граница 'ja{', а en_US игнорирует '{' при сравнении.
+ *
+ * - "col LIKE 'abc'" без шаблонных символов заменяется на "(col = 'abc' AND col LIKE 'abc')";
+ * - "col LIKE 'abc%'" заменяется на "((col >= 'abc' AND col < 'abd') AND col LIKE 'abc%')";
+ * - шаблоны, начинающиеся с '%' или '_', не изменяются и передаются в функцию диагностики.
+ *
+ * Символ '\' экранирует следующий символ шаблона. Верхняя граница получается увеличением последнего символа префикса,
+ * для символов UTF-8 увеличивается код символа целиком, чтобы граница оставалась корректной строкой.
+ * Если у префикса нет следующего значения, остается только нижняя граница.
+ *
+ * @param condition Условие.
+ * @param on_leading_wildcard Функция диагностики для шаблонов без постоянного префикса.
+ * @param recheck Сохранять исходное условие LIKE, добавляя его к диапазону через AND. Повторная проверка только
+ * отбрасывает лишние строки диапазона (например, если база данных использует другой символ экранирования),
+ * но не возвращает строки, которые диапазон исключил, поэтому не делает замену допустимой при других правилах
+ * сортировки. Значение false заменяет "col LIKE 'abc'" на "col = 'abc'", а "col LIKE 'abc%'" на диапазон без LIKE.
+ * Шаблоны с другими шаблонными символами после префикса ("abc_x%") проверяются исходным условием всегда.
+ * @return Новое дерево условий.
+ */
+condition_group rewrite_prefix_like(const condition_group& condition, const like_diagnostics_hook& on_leading_wildcard = {}, bool recheck = true);
+
+/**
+ * Вычисляет наименьшую строку, которая больше всех строк с указанным префиксом.
+ *
+ * @param prefix Префикс в кодировке UTF-8.
+ * @param successor Следующее значение.
+ * @return false, если следующего значения нет (префикс состоит только из максимальных символов).
+ */
+bool prefix_successor(const std::string& prefix, std::string& successor);
+
+} // namespace query_craft
\ No newline at end of file
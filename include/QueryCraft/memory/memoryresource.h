@@ -0,0 +1,254 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <utility>
+
+namespace query_craft {
+namespace memory {
+
+/// Интерфейс источника памяти (аналог std::pmr::memory_resource, недоступного в C++14).
+/// Позволяет подменить глобальную кучу на арену, выделенную под конкретный запрос.
+class memory_resource
+{
+public:
+    virtual ~memory_resource() = default;
+
+    /**
+     * Выделяет блок памяти.
+     *
+     * @param bytes Размер блока в байтах.
+     * @param alignment Требуемое выравнивание.
+     * @return Указатель на выделенный блок.
+     */
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Освобождает блок памяти, ранее выделенный этим источником.
+     *
+     * @param p Указатель на блок.
+     * @param bytes Размер блока в байтах.
+     * @param alignment Выравнивание, с которым блок был выделен.
+     */
+    void deallocate(void* p, std::size_t bytes, std::size_t alignment = alignof(std::max_align_t));
+
+    /**
+     * Проверяет, может ли память, выделенная одним источником, быть освобождена другим.
+     *
+     * @param other Другой источник памяти.
+     * @return true, если источники взаимозаменяемы, иначе false.
+     */
+    bool is_equal(const memory_resource& other) const noexcept;
+
+protected:
+    virtual void* do_allocate(std::size_t bytes, std::size_t alignment) = 0;
+
+    virtual void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) = 0;
+
+    virtual bool do_is_equal(const memory_resource& other) const noexcept = 0;
+};
+
+/**
+ * Возвращает источник памяти, использующий глобальные operator new/delete.
+ * @return Указатель на статический объект источника.
+ */
+memory_resource* new_delete_resource() noexcept;
+
+/**
+ * Возвращает источник памяти по умолчанию для текущего потока.
+ * @return Источник памяти, установленный через set_default_resource, либо new_delete_resource().
+ */
+memory_resource* get_default_resource() noexcept;
+
+/**
+ * Устанавливает источник памяти по умолчанию для текущего потока.
+ *
+ * @param resource Новый источник. nullptr восстанавливает new_delete_resource().
+ * @return Предыдущий источник памяти.
+ * @note В отличие от std::pmr настройка локальна для потока, чтобы обработчики запросов
+ * в разных потоках могли использовать собственные арены без синхронизации.
+ */
+memory_resource* set_default_resource(memory_resource* resource) noexcept;
+
+/// RAII-обертка, устанавливающая источник памяти по умолчанию на время жизни объекта.
+///
+/// Внутри области из источника выделяются узлы дерева условий и списки значений условий длиннее встроенного буфера.
+/// Строки значений длиннее буфера малых строк std::string выделяются в глобальной куче.
+/// Текст запроса не выделяется, если он генерируется в переиспользуемый буфер через перегрузки вида remove_sql(std::string& out, ...).
+///
+/// Объекты, созданные внутри области, не должны пережить источник: копия condition_group, сохраненная за пределами области,
+/// продолжает ссылаться на память источника. Для долгоживущих условий используйте condition_interner или создавайте их вне области.
+class scoped_resource
+{
+public:
+    explicit scoped_resource(memory_resource* resource) noexcept;
+
+    scoped_resource(const scoped_resource& other) = delete;
+
+    scoped_resource& operator=(const scoped_resource& other) = delete;
+
+    ~scoped_resource();
+
+private:
+    memory_resource* _previous = nullptr;
+};
+
+/// Монотонный источник памяти. Выделяет память последовательно из буферов,
+/// deallocate ничего не делает, вся память возвращается разом через release() или в деструкторе.
+/// Источник считает невозвращенные блоки, чтобы обнаружить объекты, пережившие арену.
+class monotonic_buffer_resource final : public memory_resource
+{
+public:
+    /**
+     * Конструктор без начального буфера.
+     *
+     * @param upstream Источник, из которого берутся новые буферы. По умолчанию get_default_resource().
+     */
+    explicit monotonic_buffer_resource(memory_resource* upstream = get_default_resource());
+
+    /**
+     * Конструктор с размером первого буфера.
+     *
+     * @param initial_size Размер первого буфера, запрашиваемого у upstream.
+     * @param upstream Источник, из которого берутся новые буферы.
+     */
+    explicit monotonic_buffer_resource(std::size_t initial_size, memory_resource* upstream = get_default_resource());
+
+    /**
+     * Конструктор с начальным буфером, предоставленным вызывающей стороной (например, на стеке).
+     *
+     * @param buffer Начальный буфер.
+     * @param buffer_size Размер начального буфера.
+     * @param upstream Источник, из которого берутся новые буферы после исчерпания начального.
+     */
+    monotonic_buffer_resource(void* buffer, std::size_t buffer_size, memory_resource* upstream = get_default_resource());
+
+    monotonic_buffer_resource(const monotonic_buffer_resource& other) = delete;
+
+    monotonic_buffer_resource& operator=(const monotonic_buffer_resource& other) = delete;
+
+    ~monotonic_buffer_resource() override;
+
+    /**
+     * Возвращает всю выделенную память upstream и восстанавливает начальный буфер.
+     * Живые блоки не проверяются: перед вызовом проверьте outstanding(), если объекты могли пережить арену.
+     */
+    void release() noexcept;
+
+    /**
+     * Возвращает количество блоков, выделенных и еще не возвращенных через deallocate.
+     * Ненулевое значение перед release() означает объект, переживший арену, например копию условия,
+     * вынесенную за пределы scoped_resource.
+     * @return Количество живых блоков.
+     */
+    std::size_t outstanding() const noexcept;
+
+    /**
+     * Возвращает источник, из которого берутся новые буферы.
+     * @return Указатель на upstream.
+     */
+    memory_resource* upstream_resource() const;
+
+protected:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+
+    bool do_is_equal(const memory_resource& other) const noexcept override;
+
+private:
+    /// Заголовок буфера, полученного от upstream. Хранится в начале самого буфера.
+    struct chunk
+    {
+        chunk* next;
+        std::size_t size;
+    };
+
+    /**
+     * Запрашивает у upstream новый буфер, способный вместить блок указанного размера.
+     * @param bytes Минимальный размер полезной части буфера.
+     * @param alignment Требуемое выравнивание блока.
+     */
+    void grow(std::size_t bytes, std::size_t alignment);
+
+private:
+    memory_resource* _upstream = nullptr;
+    void* _initial_buffer = nullptr;
+    std::size_t _initial_size = 0;
+    std::size_t _next_size = 1024;
+    char* _current = nullptr;
+    std::size_t _space = 0;
+    chunk* _chunks = nullptr;
+    std::size_t _outstanding = 0;
+};
+
+/// Аллокатор, совместимый с контейнерами стандартной библиотеки, выделяющий память из memory_resource.
+template<typename T>
+class polymorphic_allocator
+{
+public:
+    using value_type = T;
+
+    polymorphic_allocator() noexcept
+        : _resource(get_default_resource())
+    {
+    }
+
+    polymorphic_allocator(memory_resource* resource) noexcept
+        : _resource(resource)
+    {
+    }
+
+    template<typename U>
+    polymorphic_allocator(const polymorphic_allocator<U>& other) noexcept
+        : _resource(other.resource())
+    {
+    }
+
+    polymorphic_allocator(const polymorphic_allocator& other) = default;
+
+    polymorphic_allocator& operator=(const polymorphic_allocator& other) = delete;
+
+    T* allocate(std::size_t n)
+    {
+        if(n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            throw std::bad_alloc();
+
+        return static_cast<T*>(_resource->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        _resource->deallocate(p, n * sizeof(T), alignof(T));
+    }
+
+    /// Контейнеры, скопированные из контейнера на арене, получают источник по умолчанию, а не арену.
+    polymorphic_allocator select_on_container_copy_construction() const
+    {
+        return polymorphic_allocator();
+    }
+
+    memory_resource* resource() const noexcept
+    {
+        return _resource;
+    }
+
+private:
+    memory_resource* _resource = nullptr;
+};
+
+template<typename T, typename U>
+bool operator==(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept
+{
+    return lhs.resource() == rhs.resource() || lhs.resource()->is_equal(*rhs.resource());
+}
+
+template<typename T, typename U>
+bool operator!=(const polymorphic_allocator<T>& lhs, const polymorphic_allocator<U>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+
+} // namespace memory
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,420 @@
+#pragma once
+
+#include "memoryresource.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace query_craft {
+namespace memory {
+
+/// Последовательный контейнер, хранящий до N элементов внутри объекта.
+/// Память выделяется только при превышении N элементов из get_default_resource(), действующего в момент выделения.
+/// Источник запоминается в начале выделенного блока, поэтому размер контейнера не увеличивается.
+template<typename T, std::size_t N>
+class small_vector
+{
+    static_assert(N > 0, "Ошибка. Размер встроенного буфера должен быть больше нуля");
+    static_assert(N <= std::numeric_limits<uint32_t>::max(), "Ошибка. Слишком большой встроенный буфер");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+public:
+    small_vector() noexcept
+        : _data(inline_data())
+    {
+    }
+
+    small_vector(std::initializer_list<T> values)
+        : small_vector(values.begin(), values.end())
+    {
+    }
+
+    /**
+     * Конструктор из диапазона итераторов.
+     *
+     * @param first Итератор начала диапазона.
+     * @param last Итератор конца диапазона.
+     */
+    template<class InputIt, class = typename std::iterator_traits<InputIt>::iterator_category>
+    small_vector(InputIt first, InputIt last)
+        : small_vector()
+    {
+        for(; first != last; ++first)
+            emplace_back(*first);
+    }
+
+    /**
+     * Конструктор из std::vector. Элементы перемещаются.
+     *
+     * @param values Значения.
+     */
+    small_vector(std::vector<T>&& values)
+        : small_vector()
+    {
+        reserve(values.size());
+
+        for(auto& value : values)
+            emplace_back(std::move(value));
+    }
+
+    /**
+     * Конструктор из std::vector. Элементы копируются.
+     *
+     * @param values Значения.
+     */
+    small_vector(const std::vector<T>& values)
+        : small_vector(values.begin(), values.end())
+    {
+    }
+
+    small_vector(const small_vector& other)
+        : small_vector(other.begin(), other.end())
+    {
+    }
+
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+        : small_vector()
+    {
+        take(std::move(other));
+    }
+
+    small_vector& operator=(const small_vector& other)
+    {
+        if(this != &other) {
+            clear();
+            reserve(other.size());
+
+            for(const auto& value : other)
+                emplace_back(value);
+        }
+
+        return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if(this != &other) {
+            clear();
+            release();
+            take(std::move(other));
+        }
+
+        return *this;
+    }
+
+    small_vector& operator=(std::initializer_list<T> values)
+    {
+        clear();
+        reserve(values.size());
+
+        for(const auto& value : values)
+            emplace_back(value);
+
+        return *this;
+    }
+
+    ~small_vector()
+    {
+        clear();
+        release();
+    }
+
+    iterator begin() noexcept
+    {
+        return _data;
+    }
+
+    iterator end() noexcept
+    {
+        return _data + _size;
+    }
+
+    const_iterator begin() const noexcept
+    {
+        return _data;
+    }
+
+    const_iterator end() const noexcept
+    {
+        return _data + _size;
+    }
+
+    size_type size() const noexcept
+    {
+        return _size;
+    }
+
+    size_type capacity() const noexcept
+    {
+        return _capacity;
+    }
+
+    bool empty() const noexcept
+    {
+        return _size == 0;
+    }
+
+    /**
+     * Проверяет, хранятся ли элементы во встроенном буфере.
+     * @return true, если память в куче не выделялась.
+     */
+    bool is_inline() const noexcept
+    {
+        return _data == inline_data();
+    }
+
+    T* data() noexcept
+    {
+        return _data;
+    }
+
+    const T* data() const noexcept
+    {
+        return _data;
+    }
+
+    T& operator[](const size_type index)
+    {
+        return _data[index];
+    }
+
+    const T& operator[](const size_type index) const
+    {
+        return _data[index];
+    }
+
+    T& front()
+    {
+        return _data[0];
+    }
+
+    const T& front() const
+    {
+        return _data[0];
+    }
+
+    T& back()
+    {
+        return _data[_size - 1];
+    }
+
+    const T& back() const
+    {
+        return _data[_size - 1];
+    }
+
+    /**
+     * Резервирует место для указанного количества элементов.
+     * @param capacity Требуемая вместимость.
+     */
+    void reserve(const size_type capacity)
+    {
+        if(capacity <= _capacity)
+            return;
+
+        if(capacity > std::numeric_limits<uint32_t>::max())
+            throw std::length_error("Ошибка. Слишком много элементов");
+
+        auto* data = allocate(capacity);
+
+        // Элементы перемещаются, если перемещение не выбрасывает исключений, иначе копируются
+        size_type moved = 0;
+        try {
+            for(; moved < _size; moved++)
+                ::new(static_cast<void*>(data + moved)) T(std::move_if_noexcept(_data[moved]));
+        } catch(...) {
+            destroy(data, data + moved);
+            deallocate(data, capacity);
+            throw;
+        }
+
+        destroy(_data, _data + _size);
+        release();
+
+        _data = data;
+        _capacity = static_cast<uint32_t>(capacity);
+    }
+
+    template<typename... Args>
+    T& emplace_back(Args&&... args)
+    {
+        if(_size == _capacity) {
+            // Аргумент может ссылаться на элемент контейнера, поэтому значение создается до перераспределения
+            T value(std::forward<Args>(args)...);
+            reserve(static_cast<size_type>(_capacity) * 2);
+
+            ::new(static_cast<void*>(_data + _size)) T(std::move(value));
+            return _data[_size++];
+        }
+
+        ::new(static_cast<void*>(_data + _size)) T(std::forward<Args>(args)...);
+        return _data[_size++];
+    }
+
+    void push_back(const T& value)
+    {
+        emplace_back(value);
+    }
+
+    void push_back(T&& value)
+    {
+        emplace_back(std::move(value));
+    }
+
+    void pop_back()
+    {
+        _data[--_size].~T();
+    }
+
+    /**
+     * Удаляет все элементы. Выделенная память сохраняется.
+     */
+    void clear() noexcept
+    {
+        destroy(_data, _data + _size);
+        _size = 0;
+    }
+
+    /**
+     * Копирует элементы в std::vector.
+     * @return Вектор с копиями элементов.
+     */
+    std::vector<T> to_vector() const
+    {
+        return std::vector<T>(begin(), end());
+    }
+
+    /**
+     * Неявное преобразование в std::vector для кода, который хранил значения в std::vector. Элементы копируются.
+     */
+    operator std::vector<T>() const
+    {
+        return to_vector();
+    }
+
+    bool operator==(const small_vector& rhs) const
+    {
+        return _size == rhs._size && std::equal(begin(), end(), rhs.begin());
+    }
+
+    bool operator!=(const small_vector& rhs) const
+    {
+        return !(*this == rhs);
+    }
+
+private:
+    T* inline_data() noexcept
+    {
+        return reinterpret_cast<T*>(&_inline);
+    }
+
+    const T* inline_data() const noexcept
+    {
+        return reinterpret_cast<const T*>(&_inline);
+    }
+
+    static void destroy(T* first, T* last) noexcept
+    {
+        for(; first != last; ++first)
+            first->~T();
+    }
+
+    /**
+     * Выделяет блок под элементы из источника по умолчанию. Перед элементами хранится указатель на источник.
+     */
+    static T* allocate(const size_type capacity)
+    {
+        if(capacity > (std::numeric_limits<size_type>::max() - header_size) / sizeof(T))
+            throw std::bad_alloc();
+
+        auto* resource = get_default_resource();
+        auto* block = static_cast<char*>(resource->allocate(header_size + capacity * sizeof(T), block_alignment));
+
+        ::new(static_cast<void*>(block)) memory_resource*(resource);
+
+        return reinterpret_cast<T*>(block + header_size);
+    }
+
+    /**
+     * Возвращает блок, выделенный allocate, в его источник.
+     */
+    static void deallocate(T* data, const size_type capacity) noexcept
+    {
+        auto* block = reinterpret_cast<char*>(data) - header_size;
+        auto* resource = *reinterpret_cast<memory_resource**>(block);
+
+        resource->deallocate(block, header_size + capacity * sizeof(T), block_alignment);
+    }
+
+    /**
+     * Освобождает выделенную память и возвращает контейнер к встроенному буферу. Элементы должны быть уничтожены.
+     */
+    void release() noexcept
+    {
+        if(!is_inline())
+            deallocate(_data, _capacity);
+
+        _data = inline_data();
+        _capacity = N;
+    }
+
+    /**
+     * Забирает элементы пустого контейнера other. Память в куче передается без перемещения элементов.
+     */
+    void take(small_vector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+    {
+        if(!other.is_inline()) {
+            _data = other._data;
+            _size = other._size;
+            _capacity = other._capacity;
+
+            other._data = other.inline_data();
+            other._size = 0;
+            other._capacity = N;
+
+            return;
+        }
+
+        for(auto& value : other)
+            emplace_back(std::move(value));
+
+        other.clear();
+    }
+
+private:
+    /// Выравнивание блока, достаточное и для элементов, и для указателя на источник.
+    static constexpr size_type block_alignment = alignof(T) > alignof(memory_resource*) ? alignof(T) : alignof(memory_resource*);
+
+    /// Размер заголовка с указателем на источник, кратный выравниванию элементов.
+    static constexpr size_type header_size = (sizeof(memory_resource*) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    T* _data = nullptr;
+    uint32_t _size = 0;
+    uint32_t _capacity = N;
+    typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type _inline;
+};
+
+template<typename T, std::size_t N>
+constexpr typename small_vector<T, N>::size_type small_vector<T, N>::block_alignment;
+
+template<typename T, std::size_t N>
+constexpr typename small_vector<T, N>::size_type small_vector<T, N>::header_size;
+
+} // namespace memory
+} // namespace query_craft
\ No newline at end of file
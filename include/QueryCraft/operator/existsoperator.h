@@ -0,0 +1,22 @@
+#pragma once
+
+#include "ioperator.h"
+
+namespace query_craft {
+namespace operators {
+
+/// Класс, представляющий оператор "EXISTS"
+class exists_operator final : public IOperator
+{
+public:
+    ~exists_operator() override = default;
+
+    std::string sql() const override;
+
+    bool need_bracket() const override;
+
+    operator_type type() const override;
+};
+
+} // namespace operators
+} // namespace query_craft
\ No newline at end of file
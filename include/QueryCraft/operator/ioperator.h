@@ -1,5 +1,8 @@
 #pragma once
 
+#include "../enum/operatortype.h"
+
+#include <memory>
 #include <string>
 
 namespace query_craft {
@@ -24,7 +27,31 @@ public:
      * @return true, если скобки требуются, иначе false.
      */
     virtual bool need_bracket() const = 0;
+
+    /**
+     * Возвращает тип оператора.
+     *
+     * @return Тип оператора. Для пользовательских операторов operator_type::custom.
+     */
+    virtual operator_type type() const
+    {
+        return operator_type::custom;
+    }
 };
 
+/**
+ * Возвращает общий экземпляр оператора.
+ * Операторы не хранят состояния, поэтому условия разделяют один объект вместо выделения памяти под каждое условие.
+ *
+ * @tparam Operator Тип оператора.
+ * @return Указатель на общий экземпляр оператора.
+ */
+template<typename Operator>
+std::shared_ptr<IOperator> shared_instance()
+{
+    static const std::shared_ptr<IOperator> instance = std::make_shared<Operator>();
+    return instance;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
@@ -11,6 +11,8 @@ class like_operator final : public IOperator
 public:
     std::string sql() const override;
     bool need_bracket() const override;
+
+    operator_type type() const override;
 };
 
 } // namespace operators
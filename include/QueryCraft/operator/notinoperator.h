@@ -14,6 +14,8 @@ public:
     std::string sql() const override;
 
     bool need_bracket() const override;
+
+    operator_type type() const override;
 };
 
 } // namespace operators
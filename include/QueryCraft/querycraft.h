@@ -1,11 +1,30 @@
 #pragma once
 
+#include "arrayview.h"
+#include "binarycodec.h"
+#include "commontableexpression.h"
+#include "compiledcondition.h"
 #include "conditiongroup.h"
+#include "conditioninterner.h"
 #include "enum/conditionviewtype.h"
 #include "enum/logicaloperator.h"
+#include "enum/operatortype.h"
+#include "insertbatcher.h"
+#include "likerewrite.h"
+#include "memory/memoryresource.h"
 #include "operator/ioperator.h"
+#include "querylinter.h"
+#include "rangepartition.h"
+#include "rowbatch.h"
+#include "rowvalue.h"
+#include "selectquery.h"
+#include "shardedtable.h"
 #include "sortcolumn.h"
+#include "sqlcursor.h"
+#include "sqlscript.h"
 #include "sqltable.h"
+#include "subquery.h"
 #include "table.h"
+#include "tablesample.h"
 
 #include <TypeConverterApi/typeconverterapi.h>
\ No newline at end of file
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "arrayview.h"
+#include "joincolumn.h"
+#include "sortcolumn.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace query_craft {
+
+/// Структура, описывающая замечание анализатора запросов.
+struct lint_warning
+{
+    /**
+     * @brief Важность замечания.
+     */
+    enum class severity : uint8_t
+    {
+        /// Запрос может выполняться медленно в зависимости от данных.
+        info,
+
+        /// Запрос почти наверняка выполняется медленно на больших таблицах.
+        warning,
+
+        /// Запрос затрагивает все строки таблицы.
+        error
+    };
+
+    /**
+     * @brief Вид замечания.
+     */
+    enum class kind : uint8_t
+    {
+        /// Большое смещение OFFSET. База данных читает и отбрасывает все пропущенные строки.
+        large_offset,
+
+        /// Сортировка в случайном порядке. База данных сортирует всю выборку.
+        random_sort,
+
+        /// Шаблон LIKE начинается с '%' или '_' и не может использовать индекс.
+        leading_wildcard,
+
+        /// Слишком длинный список IN или NOT IN.
+        large_in_list,
+
+        /// Выборка без LIMIT, не ограниченная первичным ключом.
+        missing_limit,
+
+        /// UPDATE или DELETE без условия.
+        full_table_write
+    };
+
+    severity level = severity::info;
+    kind code = kind::large_offset;
+
+    /// Описание проблемы и способа ее исправления.
+    std::string message;
+};
+
+/// Класс, проверяющий параметры запросов на известные медленные шаблоны до генерации SQL.
+class query_linter
+{
+public:
+    /// Настройки анализатора.
+    struct settings
+    {
+        /// Смещение, начиная с которого выдается замечание.
+        size_t max_offset = 10000;
+
+        /// Количество значений IN, начиная с которого выдается замечание.
+        size_t max_in_list = 1000;
+
+        /// Выдавать замечание для выборки без LIMIT.
+        bool require_limit = true;
+
+        /// Строгий режим. Замечания с важностью error приводят к исключению.
+        bool strict = false;
+    };
+
+public:
+    query_linter() = default;
+
+    /**
+     * Конструктор с указанием настроек.
+     *
+     * @param settings Настройки анализатора.
+     */
+    explicit query_linter(settings settings);
+
+    /**
+     * Проверяет параметры select_sql.
+     *
+     * @param join_columns   Информация о join соединениях
+     * @param condition     Условие для выбора строк.
+     * @param sort_columns   Информация о колонках необходимых для сортировок
+     * @param limit         Лимит выборки.
+     * @param offset        Смещение выборки.
+     * @return Список замечаний.
+     */
+    std::vector<lint_warning> check_select(
+        array_view<join_column> join_columns = {},
+        const condition_group& condition = {},
+        array_view<sort_column> sort_columns = {},
+        size_t limit = 0,
+        size_t offset = 0) const;
+
+    /**
+     * Проверяет параметры update_sql.
+     *
+     * @param condition Условие для выбора строк.
+     * @return Список замечаний.
+     * @throw std::logic_error В строгом режиме, если условие пустое.
+     */
+    std::vector<lint_warning> check_update(const condition_group& condition = {}) const;
+
+    /**
+     * Проверяет параметры remove_sql.
+     *
+     * @param condition Условие для выбора строк.
+     * @return Список замечаний.
+     * @throw std::logic_error В строгом режиме, если условие пустое.
+     */
+    std::vector<lint_warning> check_remove(const condition_group& condition = {}) const;
+
+    /**
+     * Проверяет дерево условий.
+     *
+     * @param condition Условие.
+     * @return Список замечаний.
+     */
+    std::vector<lint_warning> check_condition(const condition_group& condition) const;
+
+private:
+    /**
+     * Добавляет замечания для каждого отдельного условия дерева.
+     */
+    void check_tree(const condition_group& node, std::vector<lint_warning>& warnings) const;
+
+    /**
+     * Проверяет условие изменения строк и в строгом режиме отклоняет изменение всей таблицы.
+     */
+    std::vector<lint_warning> check_write(const condition_group& condition, const char* statement) const;
+
+    /**
+     * Проверяет, ограничивает ли условие выборку конкретными значениями первичного ключа.
+     */
+    static bool pins_primary_key(const condition_group& node);
+
+private:
+    settings _settings {};
+};
+
+} // namespace query_craft
\ No newline at end of file
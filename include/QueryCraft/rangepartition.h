@@ -0,0 +1,157 @@
+#pragma once
+
+#include "arrayview.h"
+#include "sqltable.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace query_craft {
+
+/**
+ * Разбивает значения столбца на непересекающиеся диапазоны по границам.
+ * Для границ b1 < b2 < ... < bk создается k + 1 условие:
+ * "key < b1 OR key IS NULL", "key >= b1 AND key < b2", ..., "key >= bk".
+ * Каждая строка таблицы удовлетворяет ровно одному условию, включая строки с NULL.
+ *
+ * @tparam T Тип границ, который может быть преобразован в строку.
+ * @param key Упорядочиваемый столбец, по которому выполняется разбиение.
+ * @param boundaries Строго возрастающие границы диапазонов.
+ * @return Условия для каждого диапазона.
+ */
+template<typename T>
+std::vector<condition_group> range_partition_conditions(const column_info& key, const std::vector<T>& boundaries)
+{
+    for(size_t i = 1; i < boundaries.size(); i++) {
+        if(!(boundaries[i - 1] < boundaries[i]))
+            throw std::invalid_argument("Ошибка. Границы диапазонов должны строго возрастать");
+    }
+
+    std::vector<condition_group> conditions;
+    conditions.reserve(boundaries.size() + 1);
+
+    if(boundaries.empty()) {
+        conditions.emplace_back();
+        return conditions;
+    }
+
+    conditions.emplace_back(key < boundaries.front() || key.is_null());
+
+    for(size_t i = 1; i < boundaries.size(); i++)
+        conditions.emplace_back(key >= boundaries[i - 1] && key < boundaries[i]);
+
+    conditions.emplace_back(key >= boundaries.back());
+
+    return conditions;
+}
+
+/**
+ * Вычисляет равномерные границы для разбиения целочисленного диапазона [min_value, max_value] на partition_count частей.
+ *
+ * @tparam T Целочисленный тип.
+ * @param min_value Минимальное значение столбца.
+ * @param max_value Максимальное значение столбца.
+ * @param partition_count Количество частей.
+ * @return Строго возрастающие границы (не более partition_count - 1).
+ */
+template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+std::vector<T> uniform_boundaries(const T min_value, const T max_value, const size_t partition_count)
+{
+    if(partition_count == 0)
+        throw std::invalid_argument("Ошибка. Количество частей должно быть больше нуля");
+
+    if(max_value < min_value)
+        throw std::invalid_argument("Ошибка. Минимальное значение больше максимального");
+
+    // Разность считается в беззнаковом типе, чтобы не переполниться на краях диапазона знакового типа
+    const auto range = static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value);
+
+    std::vector<T> boundaries;
+    boundaries.reserve(partition_count - 1);
+
+    for(size_t i = 1; i < partition_count; i++) {
+        const auto offset = static_cast<uint64_t>(static_cast<long double>(range) * i / partition_count) + 1;
+        const auto boundary = static_cast<T>(static_cast<uint64_t>(min_value) + offset);
+
+        if(offset > range || (!boundaries.empty() && !(boundaries.back() < boundary)))
+            continue;
+
+        boundaries.push_back(boundary);
+    }
+
+    return boundaries;
+}
+
+/**
+ * Разбивает запрос на выборку на непересекающиеся запросы по диапазонам столбца для параллельного чтения.
+ * Объединение результатов всех запросов совпадает с результатом исходного запроса с условием base_condition.
+ *
+ * @tparam T Тип границ, который может быть преобразован в строку.
+ * @param table Таблица, из которой выполняется выборка.
+ * @param key Упорядочиваемый столбец, по которому выполняется разбиение (обычно первичный ключ).
+ * @param boundaries Строго возрастающие границы диапазонов.
+ * @param base_condition Исходное условие, к которому через AND добавляется условие диапазона.
+ * @param join_columns Информация о join соединениях.
+ * @param columns Столбцы для выборки. По умолчанию все столбцы.
+ * @return boundaries.size() + 1 запросов на выборку.
+ */
+template<typename T>
+std::vector<std::string> partition_select_sql(const sql_table& table,
+    const column_info& key,
+    const std::vector<T>& boundaries,
+    const condition_group& base_condition = {},
+    array_view<join_column> join_columns = {},
+    array_view<column_info> columns = {})
+{
+    const auto ranges = range_partition_conditions(key, boundaries);
+
+    std::vector<std::string> queries;
+    queries.reserve(ranges.size());
+
+    for(const auto& range : ranges) {
+        condition_group condition;
+
+        if(!range.is_valid())
+            condition = base_condition;
+        else if(!base_condition.is_valid())
+            condition = range;
+        else
+            condition = base_condition && range;
+
+        queries.emplace_back(table.select_sql(join_columns, condition, {}, 0, 0, columns));
+    }
+
+    return queries;
+}
+
+/**
+ * Разбивает запрос на выборку на partition_count непересекающихся запросов по равномерным диапазонам целочисленного столбца.
+ *
+ * @tparam T Целочисленный тип.
+ * @param table Таблица, из которой выполняется выборка.
+ * @param key Целочисленный столбец, по которому выполняется разбиение.
+ * @param min_value Минимальное значение столбца.
+ * @param max_value Максимальное значение столбца.
+ * @param partition_count Количество частей.
+ * @param base_condition Исходное условие, к которому через AND добавляется условие диапазона.
+ * @param join_columns Информация о join соединениях.
+ * @param columns Столбцы для выборки. По умолчанию все столбцы.
+ * @return Не более partition_count запросов на выборку.
+ * @note Значения вне [min_value, max_value] попадают в крайние части, поэтому устаревшие min/max не приводят к потере строк.
+ */
+template<typename T, typename = std::enable_if_t<std::is_integral<T>::value>>
+std::vector<std::string> partition_select_sql(const sql_table& table,
+    const column_info& key,
+    const T min_value,
+    const T max_value,
+    const size_t partition_count,
+    const condition_group& base_condition = {},
+    array_view<join_column> join_columns = {},
+    array_view<column_info> columns = {})
+{
+    return partition_select_sql(table, key, uniform_boundaries(min_value, max_value, partition_count), base_condition, join_columns, columns);
+}
+
+} // namespace query_craft
\ No newline at end of file
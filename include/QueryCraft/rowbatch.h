@@ -0,0 +1,164 @@
+#pragma once
+
+#include "sqltable.h"
+
+#include <memory>
+
+namespace query_craft {
+
+/// Неизменяемое описание таблицы, которое можно разделять между потоками без блокировок.
+using shared_schema = std::shared_ptr<const sql_table>;
+
+/**
+ * Создает разделяемое описание таблицы.
+ *
+ * @param table Таблица, из которой копируется описание. Добавленные в нее строки не копируются.
+ * @return Разделяемое неизменяемое описание таблицы.
+ */
+shared_schema make_shared_schema(const table& table);
+
+/// Класс, представляющий буфер строк для вставки или обновления, привязанный к разделяемому описанию таблицы.
+/// Каждый поток создает собственный row_batch, описание таблицы при этом не копируется.
+class row_batch
+{
+public:
+    /// Тип, представляющий строку таблицы.
+    using row = sql_table::row;
+
+public:
+    /**
+     * Конструктор с указанием описания таблицы.
+     *
+     * @param schema Разделяемое описание таблицы.
+     */
+    explicit row_batch(shared_schema schema);
+
+    row_batch(const row_batch& other) = default;
+
+    row_batch(row_batch&& other) noexcept = default;
+
+    row_batch& operator=(const row_batch& other) = default;
+
+    row_batch& operator=(row_batch&& other) noexcept = default;
+
+    /**
+     * Добавление строки в буфер.
+     *
+     * @param row Строка для добавления.
+     * @return Ссылка на текущий буфер.
+     */
+    row_batch& add_row(const row& row);
+
+    /**
+     * Добавление строки в буфер без копирования значений.
+     *
+     * @param row Строка для добавления.
+     * @return Ссылка на текущий буфер.
+     */
+    row_batch& add_row(row&& row);
+
+    /**
+     * Добавление диапазона строк в буфер.
+     * Для однонаправленных итераторов память под строки резервируется заранее.
+     *
+     * @param first Итератор начала диапазона строк.
+     * @param last Итератор конца диапазона строк.
+     * @return Ссылка на текущий буфер.
+     */
+    template<class InputIt>
+    row_batch& add_rows(InputIt first, InputIt last)
+    {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if(std::is_base_of<std::forward_iterator_tag, category>::value)
+            _rows.reserve(_rows.size() + static_cast<size_t>(std::distance(first, last)));
+
+        for(; first != last; ++first)
+            add_row(*first);
+
+        return *this;
+    }
+
+    /**
+     * Добавление строки в буфер с использованием переменного числа аргументов.
+     *
+     * @param args Значения для добавления в качестве столбцов.
+     * @return Ссылка на текущий буфер.
+     */
+    template<typename... Args>
+    row_batch& emplace_row(Args&&... args)
+    {
+        return add_row(sql_table::make_row(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Добавление строки в буфер с использованием переменного числа аргументов.
+     *
+     * @param args Значения для добавления в качестве столбцов.
+     * @return Ссылка на текущий буфер.
+     */
+    template<typename... Args>
+    row_batch& add_row_args(Args&&... args)
+    {
+        return emplace_row(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Генерация SQL-запроса для вставки строк буфера.
+     *
+     * @param columns Столбцы для вставки. По умолчанию все столбцы.
+     * @param need_returning Флаг означающий что в конце запроса необходимо вернуть вставленные колонки
+     * @param returning_columns Колонки которые необходимо вернуть после вставки
+     * @return SQL-запрос для вставки.
+     * @note Очищает добавленные строки
+     */
+    std::string insert_sql(array_view<column_info> columns = {}, bool need_returning = false, array_view<column_info> returning_columns = {});
+
+    /**
+     * Генерация SQL-запроса для обновления строки буфера.
+     *
+     * @param condition Условие для выбора строки.
+     * @param columns   Столбцы для обновления. По умолчанию все столбцы.
+     * @return SQL-запрос для обновления.
+     * @note Очищает добавленные строки
+     */
+    std::string update_sql(const condition_group& condition = {}, array_view<column_info> columns = {});
+
+    /**
+     * Удаляет все строки из буфера, сохраняя выделенную память.
+     */
+    void clear();
+
+    /**
+     * Возвращает количество строк в буфере.
+     * @return Количество строк.
+     */
+    size_t size() const;
+
+    /**
+     * Проверяет, пуст ли буфер.
+     * @return true, если строк нет, иначе false.
+     */
+    bool empty() const;
+
+    /**
+     * Возвращает описание таблицы, к которому привязан буфер.
+     * @return Ссылка на описание таблицы.
+     */
+    const sql_table& schema() const;
+
+private:
+    /**
+     * Проверяет, что строку можно добавить к уже добавленным строкам.
+     */
+    void check_row(const row& row) const;
+
+private:
+    /// Разделяемое описание таблицы.
+    shared_schema _schema;
+
+    /// Вектор, содержащий строки буфера.
+    std::vector<row> _rows;
+};
+
+} // namespace query_craft
\ No newline at end of file
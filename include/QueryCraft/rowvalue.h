@@ -0,0 +1,127 @@
+#pragma once
+
+#include "helper/sqlrenderer.h"
+#include "helper/tuplehelper.h"
+
+#include <TypeConverterApi/typeconverterapi.h>
+
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace query_craft {
+namespace helper {
+
+/**
+ * Добавляет кортеж значений вида "('1', 'a''b')" с экранированием каждого значения.
+ *
+ * @param out Буфер.
+ * @param tuple Кортеж значений, каждое из которых преобразуется через type_converter.
+ * @return Количество значений в кортеже.
+ */
+template<typename... Args>
+size_t append_row_value(std::string& out, const std::tuple<Args...>& tuple)
+{
+    out.append("(");
+
+    size_t count = 0;
+    helper::for_each(tuple, [&out, &count](auto&& value) {
+        if(count++ != 0)
+            out.append(", ");
+
+        append_escaped_value(out, type_converter_api::type_converter<decltype(value)>().convert_to_string(value));
+    });
+
+    out.append(")");
+
+    return count;
+}
+
+/**
+ * Добавляет пару значений вида "('1', '2')".
+ *
+ * @param out Буфер.
+ * @param pair Пара значений.
+ * @return Количество значений (2).
+ */
+template<typename First, typename Second>
+size_t append_row_value(std::string& out, const std::pair<First, Second>& pair)
+{
+    return append_row_value(out, std::tie(pair.first, pair.second));
+}
+
+/**
+ * Добавляет строку таблицы, уже преобразованную в строки, в виде кортежа.
+ *
+ * @param out Буфер.
+ * @param values Значения столбцов.
+ * @return Количество значений.
+ */
+size_t append_row_value(std::string& out, const std::vector<std::string>& values);
+
+} // namespace helper
+
+/**
+ * Создает условие вхождения составного ключа в список кортежей: "(a, b) IN (('1', '2'), ('3', '4'))".
+ * Списки длиннее chunk_size разбиваются на части, объединенные через OR,
+ * чтобы не превышать ограничения базы данных на размер списка.
+ *
+ * @param columns Столбцы составного ключа.
+ * @param start_it Итератор начала диапазона кортежей (std::tuple, std::pair или вектор строк).
+ * @param end_it Итератор конца диапазона кортежей.
+ * @param chunk_size Максимальное количество кортежей в одном списке IN.
+ * @return Условие.
+ */
+template<class StartIt, class EndIt>
+condition_group row_in_list(const std::vector<column_info>& columns, StartIt start_it, EndIt end_it, const size_t chunk_size = 1000)
+{
+    if(chunk_size == 0)
+        throw std::invalid_argument("Ошибка. Размер части списка должен быть больше нуля");
+
+    condition_group result;
+    condition_info::value_list tuples;
+
+    const auto flush = [&result, &tuples, &columns]() {
+        auto chunk = condition_info::row_in(columns, std::move(tuples));
+        result = result.is_valid() ? result || chunk : condition_group(chunk);
+        tuples.clear();
+    };
+
+    for(; start_it != end_it; ++start_it) {
+        std::string tuple;
+
+        if(helper::append_row_value(tuple, *start_it) != columns.size())
+            throw std::invalid_argument("Ошибка. Размер кортежа не совпадает с количеством столбцов");
+
+        tuples.push_back(std::move(tuple));
+
+        if(tuples.size() == chunk_size)
+            flush();
+    }
+
+    if(!tuples.empty())
+        flush();
+
+    if(!result.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой список кортежей");
+
+    return result;
+}
+
+/**
+ * Создает условие вхождения составного ключа в список кортежей.
+ *
+ * @param columns Столбцы составного ключа.
+ * @param tuples Кортежи (std::tuple, std::pair или вектор строк).
+ * @param chunk_size Максимальное количество кортежей в одном списке IN.
+ * @return Условие.
+ */
+template<typename Tuple>
+condition_group row_in(const std::vector<column_info>& columns, const std::vector<Tuple>& tuples, const size_t chunk_size = 1000)
+{
+    return row_in_list(columns, tuples.begin(), tuples.end(), chunk_size);
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,170 @@
+#pragma once
+
+#include "binarycodec.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace query_craft {
+
+/// Класс, представляющий изменяемый запрос на выборку.
+/// Каждая часть запроса (список столбцов, FROM, JOIN, WHERE, ORDER BY, LIMIT/OFFSET) запоминается в сгенерированном виде,
+/// поэтому повторный вызов sql() генерирует заново только части, измененные после предыдущего вызова.
+/// Подходит для постраничной выборки, где между запросами меняется только смещение или одно условие.
+class select_query
+{
+public:
+    /**
+     * Конструктор с указанием таблицы.
+     *
+     * @param source Таблица, из которой выполняется выборка.
+     */
+    explicit select_query(table source);
+
+    /**
+     * Конструктор по описанию выборки.
+     *
+     * @param description Описание выборки.
+     */
+    explicit select_query(select_description description);
+
+    /**
+     * Заменяет таблицу, из которой выполняется выборка.
+     *
+     * @param source Таблица.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& from(table source);
+
+    /**
+     * Добавляет соединение таблиц.
+     *
+     * @param join Информация о join соединении.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& join(join_column join);
+
+    /**
+     * Заменяет все соединения таблиц.
+     *
+     * @param joins Информация о join соединениях.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& joins(std::vector<join_column> joins);
+
+    /**
+     * Заменяет условие выборки.
+     *
+     * @param condition Условие для выбора строк. Пустое условие убирает WHERE.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& where(condition_group condition);
+
+    /**
+     * Заменяет сортировку.
+     *
+     * @param sorts Информация о колонках необходимых для сортировок.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& order_by(std::vector<sort_column> sorts);
+
+    /**
+     * Устанавливает лимит выборки.
+     *
+     * @param limit Лимит выборки. 0 убирает LIMIT.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& limit(size_t limit);
+
+    /**
+     * Устанавливает смещение выборки.
+     *
+     * @param offset Смещение выборки. 0 убирает OFFSET.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& offset(size_t offset);
+
+    /**
+     * Заменяет столбцы для выборки.
+     *
+     * @param columns Столбцы для выборки. Если пусто, выбираются все столбцы таблицы.
+     * @return Ссылка на текущий запрос.
+     */
+    select_query& columns(std::vector<column_info> columns);
+
+    /**
+     * Генерация SQL-запроса для выборки.
+     * Части запроса, не изменившиеся с предыдущего вызова, не генерируются заново.
+     *
+     * @return Ссылка на SQL-запрос. Действительна до следующего изменения запроса.
+     * @note Запоминает сгенерированные части, поэтому не должен вызываться одновременно из разных потоков
+     */
+    const std::string& sql();
+
+    /**
+     * Генерация SQL-запроса для выборки в конец переданного буфера.
+     *
+     * @param out Буфер, в конец которого добавляется запрос.
+     */
+    void sql(std::string& out);
+
+    /**
+     * Возвращает описание выборки, например для передачи в двоичном виде.
+     *
+     * @return Описание выборки.
+     */
+    select_description description() const;
+
+private:
+    /**
+     * @brief Части запроса в порядке следования в SQL.
+     */
+    enum class clause : uint8_t
+    {
+        select_list,
+        from,
+        joins,
+        where,
+        order_by,
+        limit_offset
+    };
+
+    /// Количество частей запроса.
+    static constexpr size_t clause_count = 6;
+
+    /**
+     * Отмечает часть запроса как измененную.
+     *
+     * @param part Часть запроса.
+     */
+    void invalidate(clause part);
+
+    /**
+     * Генерирует часть запроса в ее буфер.
+     *
+     * @param part Часть запроса.
+     */
+    void render(clause part);
+
+private:
+    /// Описание выборки.
+    select_description _description;
+
+    /// Сгенерированные части запроса.
+    std::string _fragments[clause_count];
+
+    /// Позиции начала частей запроса в _sql.
+    size_t _offsets[clause_count] {};
+
+    /// Битовая маска частей, измененных после последнего вызова sql().
+    uint8_t _dirty = (1 << clause_count) - 1;
+
+    /// Первая часть, которую нужно заново скопировать в _sql. Все последующие части копируются вместе с ней.
+    size_t _first_changed = 0;
+
+    /// Собранный запрос.
+    std::string _sql;
+};
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,268 @@
+#pragma once
+
+#include "rowbatch.h"
+
+#include <functional>
+#include <unordered_map>
+
+namespace query_craft {
+
+/// Функция, определяющая номер шарда по строковому значению ключевого столбца.
+using shard_router = std::function<size_t(const std::string& key_value)>;
+
+/**
+ * Создает функцию распределения по хешу ключа.
+ * Используется FNV-1a, поэтому распределение не зависит от реализации стандартной библиотеки и стабильно между запусками.
+ *
+ * @param shard_count Количество шардов.
+ * @return Функция распределения.
+ */
+shard_router hash_router(size_t shard_count);
+
+/**
+ * Создает функцию распределения по диапазонам целочисленного ключа.
+ * Шард i содержит ключи из диапазона [boundaries[i - 1], boundaries[i]), поэтому шардов на один больше, чем границ.
+ * Значение NULL попадает в первый шард.
+ *
+ * @param boundaries Возрастающие границы диапазонов.
+ * @return Функция распределения.
+ */
+shard_router range_router(std::vector<long long> boundaries);
+
+/// Класс, представляющий таблицу, строки которой распределены по нескольким шардам.
+/// Шардами могут быть таблицы table_0..table_N в одной базе либо одноименные таблицы в разных базах.
+/// Условия, столбцы и сортировки строятся по логической таблице и при генерации запросов переносятся на таблицу шарда.
+/// Вложенные запросы (IN (SELECT ...), EXISTS) переносятся без изменений, так как их текст уже сгенерирован.
+/// Вложенный запрос к самой логической таблице отклоняется: на шарде он читал бы несуществующую логическую таблицу.
+class sharded_table
+{
+public:
+    /// Тип, представляющий строку таблицы.
+    using row = sql_table::row;
+
+    /// Запрос, предназначенный для конкретного шарда.
+    struct statement
+    {
+        /// Номер шарда.
+        size_t shard;
+
+        /// SQL-запрос.
+        std::string sql;
+    };
+
+public:
+    /**
+     * Конструктор, создающий шарды с именами "<имя таблицы>_<номер>" в схеме логической таблицы.
+     *
+     * @param logical Логическая таблица.
+     * @param shard_count Количество шардов.
+     * @param key_column Имя столбца, по которому распределяются строки.
+     * @param router Функция распределения. По умолчанию hash_router(shard_count).
+     */
+    sharded_table(const table& logical, size_t shard_count, const std::string& key_column, shard_router router = {});
+
+    /**
+     * Конструктор с явным перечислением таблиц шардов.
+     *
+     * @param logical Логическая таблица.
+     * @param shards Таблицы шардов. Должны содержать те же столбцы, что и логическая таблица.
+     * @param key_column Имя столбца, по которому распределяются строки.
+     * @param router Функция распределения. По умолчанию hash_router(shards.size()).
+     */
+    sharded_table(const table& logical, const std::vector<table>& shards, const std::string& key_column, shard_router router = {});
+
+    /**
+     * Добавление строки в буфер шарда, определенного по значению ключевого столбца.
+     *
+     * @param row Строка со значениями всех столбцов логической таблицы.
+     * @return Ссылка на текущую таблицу.
+     */
+    sharded_table& add_row(const row& row);
+
+    /**
+     * Добавление строки в буфер шарда без копирования значений.
+     *
+     * @param row Строка со значениями всех столбцов логической таблицы.
+     * @return Ссылка на текущую таблицу.
+     */
+    sharded_table& add_row(row&& row);
+
+    /**
+     * Добавление диапазона строк. Каждая строка попадает в буфер своего шарда.
+     *
+     * @param first Итератор начала диапазона строк.
+     * @param last Итератор конца диапазона строк.
+     * @return Ссылка на текущую таблицу.
+     */
+    template<class InputIt>
+    sharded_table& add_rows(InputIt first, InputIt last)
+    {
+        for(; first != last; ++first)
+            add_row(*first);
+
+        return *this;
+    }
+
+    /**
+     * Добавление строки с использованием переменного числа аргументов.
+     *
+     * @param args Значения всех столбцов логической таблицы.
+     * @return Ссылка на текущую таблицу.
+     */
+    template<typename... Args>
+    sharded_table& emplace_row(Args&&... args)
+    {
+        return add_row(sql_table::make_row(std::forward<Args>(args)...));
+    }
+
+    /**
+     * Добавление строки с использованием переменного числа аргументов.
+     *
+     * @param args Значения всех столбцов логической таблицы.
+     * @return Ссылка на текущую таблицу.
+     */
+    template<typename... Args>
+    sharded_table& add_row_args(Args&&... args)
+    {
+        return emplace_row(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Генерация SQL-запросов для вставки накопленных строк, по одному запросу на каждый непустой шард.
+     *
+     * @param need_returning Флаг означающий что в конце запроса необходимо вернуть вставленные колонки
+     * @param returning_columns Колонки которые необходимо вернуть после вставки
+     * @return Запросы для вставки.
+     * @note Очищает добавленные строки
+     */
+    std::vector<statement> insert_sql(bool need_returning = false, array_view<column_info> returning_columns = {});
+
+    /**
+     * Определяет шарды, в которых могут находиться строки, удовлетворяющие условию.
+     * Учитываются условия "=", "IN" и "IS NULL" по ключевому столбцу, объединенные через AND и OR.
+     * Для остальных условий возвращаются все шарды.
+     *
+     * @param condition Условие для выбора строк.
+     * @return Возрастающий список номеров шардов.
+     */
+    std::vector<size_t> target_shards(const condition_group& condition) const;
+
+    /**
+     * Генерация SQL-запросов для выборки строк из шардов, затрагиваемых условием.
+     *
+     * @param join_columns   Информация о join соединениях
+     * @param condition     Условие для выбора строк.
+     * @param sort_columns   Информация о колонках необходимых для сортировок
+     * @param limit         Лимит выборки.
+     * @param offset        Смещение выборки.
+     * @param columns       Столбцы для выборки. По умолчанию все столбцы.
+     * @return Запросы для выборки.
+     * @note Если затронуто несколько шардов, каждый запрос получает LIMIT limit + offset без OFFSET,
+     * а сортировка и смещение применяются при слиянии результатов.
+     * @throw std::invalid_argument Если условие содержит вложенный запрос к логической таблице.
+     */
+    std::vector<statement> select_sql(
+        array_view<join_column> join_columns = {},
+        const condition_group& condition = {},
+        array_view<sort_column> sort_columns = {},
+        size_t limit = 0,
+        size_t offset = 0,
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация SQL-запросов для удаления строк из шардов, затрагиваемых условием.
+     *
+     * @param condition Условие для выбора строк.
+     * @return Запросы для удаления.
+     * @throw std::invalid_argument Если условие содержит вложенный запрос к логической таблице.
+     */
+    std::vector<statement> remove_sql(const condition_group& condition = {}) const;
+
+    /**
+     * Получение информации о столбце логической таблицы.
+     *
+     * @param name Имя столбца.
+     * @return Информация о столбце.
+     */
+    column_info column(const std::string& name) const;
+
+    /**
+     * Возвращает логическую таблицу.
+     * @return Ссылка на логическую таблицу.
+     */
+    const table& logical_table() const;
+
+    /**
+     * Возвращает таблицу шарда.
+     * @param index Номер шарда.
+     * @return Ссылка на таблицу шарда.
+     */
+    const sql_table& shard(size_t index) const;
+
+    /**
+     * Возвращает количество шардов.
+     * @return Количество шардов.
+     */
+    size_t shard_count() const;
+
+    /**
+     * Возвращает количество накопленных строк во всех шардах.
+     * @return Количество строк.
+     */
+    size_t pending_rows() const;
+
+private:
+    /**
+     * Проверяет описание шардов и подготавливает буферы строк.
+     */
+    void init();
+
+    /**
+     * Возвращает номер шарда для значения ключа с проверкой результата функции распределения.
+     * @param key_value Значение ключевого столбца.
+     * @return Номер шарда.
+     */
+    size_t route(const std::string& key_value) const;
+
+    /**
+     * Помечает шарды, затрагиваемые условием.
+     * @param node Узел дерева условий.
+     * @return Маска шардов.
+     */
+    std::vector<bool> shard_mask(const condition_group& node) const;
+
+    /**
+     * Переносит столбец логической таблицы на таблицу шарда. Столбцы других таблиц не изменяются.
+     */
+    column_info map_column(const column_info& column, const sql_table& shard) const;
+
+    /**
+     * Переносит условие с логической таблицы на таблицу шарда, включая ссылки на столбцы в значениях.
+     * @throw std::invalid_argument Если условие содержит вложенный запрос к логической таблице.
+     */
+    condition_group map_condition(const condition_group& condition, const sql_table& shard) const;
+
+private:
+    /// Логическая таблица.
+    table _logical;
+
+    /// Описания таблиц шардов.
+    std::vector<shared_schema> _shards;
+
+    /// Буферы строк для вставки, по одному на шард.
+    std::vector<row_batch> _batches;
+
+    /// Имя ключевого столбца.
+    std::string _key_column;
+
+    /// Номер ключевого столбца в строке.
+    size_t _key_index = 0;
+
+    /// Функция распределения.
+    shard_router _router;
+
+    /// Соответствие полного имени столбца логической таблицы его короткому имени.
+    std::unordered_map<std::string, std::string> _logical_full_names;
+};
+
+} // namespace query_craft
\ No newline at end of file
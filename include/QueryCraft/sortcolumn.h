@@ -28,6 +28,12 @@ sort_column asc_sort(const column_info& column);
 
 sort_column desc_sort(const column_info& column);
 
+/**
+ * Возвращает сортировку в случайном порядке (ORDER BY RANDOM ()).
+ * @return Информация о сортировке.
+ * @note База данных сортирует всю отфильтрованную выборку. Для выбора нескольких случайных строк из большой таблицы
+ * используйте sql_table::sample_select_sql или sql_table::random_keys_select_sql.
+ */
 sort_column random_sort();
 
 } // namespace query_craft
\ No newline at end of file
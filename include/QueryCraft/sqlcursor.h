@@ -0,0 +1,91 @@
+#pragma once
+
+#include "subquery.h"
+
+#include <cstdint>
+#include <string>
+
+namespace query_craft {
+
+/// Класс, генерирующий запросы для работы с серверным курсором (DECLARE / FETCH / CLOSE в PostgreSQL).
+/// Позволяет читать большой результат пачками фиксированного размера, не буферизуя его целиком ни на клиенте, ни на сервере.
+/// Каждый метод возвращает ровно один запрос, поэтому запросы можно выполнять через расширенный протокол
+/// и подготовленные запросы. Транзакцией управляет вызывающая сторона: курсор scope::transaction объявляется
+/// после BEGIN, а COMMIT отправляется после close_sql() отдельными запросами.
+class sql_cursor
+{
+public:
+    /**
+     * @brief Время жизни курсора.
+     */
+    enum class scope : uint8_t
+    {
+        /// Курсор живет до конца транзакции и должен быть объявлен внутри нее.
+        transaction,
+
+        /// Курсор переживает фиксацию транзакции (WITH HOLD) и должен быть закрыт явно.
+        with_hold
+    };
+
+public:
+    /**
+     * Конструктор курсора.
+     *
+     * @param name Имя курсора.
+     * @param query Запрос, результат которого читается через курсор.
+     * @param cursor_scope Время жизни курсора.
+     * @param scroll Разрешить перемещение курсора назад (SCROLL). По умолчанию NO SCROLL, что дешевле для сервера.
+     */
+    sql_cursor(std::string name, sub_query query, scope cursor_scope = scope::transaction, bool scroll = false);
+
+    /**
+     * Генерация запроса для объявления курсора.
+     *
+     * @return SQL-запрос вида "DECLARE name NO SCROLL CURSOR [WITH HOLD] FOR ...;".
+     * @note Курсор scope::transaction должен объявляться внутри транзакции, см. requires_transaction().
+     */
+    std::string open_sql() const;
+
+    /**
+     * Генерация запроса для чтения очередной пачки строк.
+     *
+     * @param count Количество строк в пачке.
+     * @return SQL-запрос вида "FETCH FORWARD count FROM name;".
+     * @note Пачка, содержащая меньше count строк, означает конец результата.
+     */
+    std::string fetch_sql(size_t count) const;
+
+    /**
+     * Генерация запроса для закрытия курсора.
+     *
+     * @return SQL-запрос вида "CLOSE name;".
+     */
+    std::string close_sql() const;
+
+    /**
+     * Возвращает имя курсора.
+     * @return Имя курсора.
+     */
+    const std::string& name() const;
+
+    /**
+     * Проверяет, должен ли курсор объявляться внутри транзакции, открытой вызывающей стороной.
+     * @return true для курсора scope::transaction.
+     */
+    bool requires_transaction() const;
+
+private:
+    /**
+     * Добавляет имя курсора в кавычках. Кавычки внутри имени удваиваются.
+     * @param out Буфер.
+     */
+    void append_name(std::string& out) const;
+
+private:
+    std::string _name;
+    sub_query _query;
+    scope _scope = scope::transaction;
+    bool _scroll = false;
+};
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,152 @@
+#pragma once
+
+#include "../table.h"
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct sqlite3;
+
+namespace query_craft {
+namespace sqlite {
+
+/// Исключение, выбрасываемое при ошибке выполнения запроса SQLite.
+class error : public std::runtime_error
+{
+public:
+    /// Значение offset(), если позиция запроса неизвестна.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+public:
+    /**
+     * Конструктор.
+     *
+     * @param message Сообщение об ошибке.
+     * @param code Код ошибки SQLite.
+     * @param offset Смещение запроса, вызвавшего ошибку, в выполняемом тексте.
+     */
+    error(const std::string& message, int code, size_t offset = npos);
+
+    /**
+     * Возвращает код ошибки SQLite.
+     * @return Код ошибки.
+     */
+    int code() const noexcept;
+
+    /**
+     * Возвращает смещение запроса, вызвавшего ошибку, в выполняемом тексте.
+     * Для скрипта номер запроса можно получить через sql_script::find_statement.
+     * @return Смещение запроса либо npos.
+     */
+    size_t offset() const noexcept;
+
+private:
+    int _code;
+    size_t _offset;
+};
+
+/// Класс, выполняющий сгенерированные запросы во встроенной базе данных SQLite.
+/// Нужен для проверки и замера сгенерированных запросов без сетевого сервера баз данных.
+/// Схемы таблиц, кроме main и temp, подключаются как отдельные базы данных, поэтому имена вида "schema"."table" работают без изменений.
+/// Значение NULL в результатах представлено column_info::null_value(), как и в строках sql_table.
+class executor
+{
+public:
+    /// Тип, представляющий строку результата.
+    using row = std::vector<std::string>;
+
+    /// Функция, вызываемая для каждой строки результата. Строка переиспользуется между вызовами.
+    using row_handler = std::function<void(const row&)>;
+
+public:
+    /**
+     * Открывает базу данных.
+     *
+     * @param path Путь к файлу базы данных. По умолчанию база данных создается в памяти.
+     * @throw error Если базу данных не удалось открыть.
+     */
+    explicit executor(const std::string& path = ":memory:");
+
+    executor(const executor& other) = delete;
+
+    executor(executor&& other) noexcept;
+
+    executor& operator=(const executor& other) = delete;
+
+    executor& operator=(executor&& other) noexcept;
+
+    ~executor();
+
+    /**
+     * Подключает базу данных под именем схемы.
+     *
+     * @param scheme Имя схемы.
+     * @param path Путь к файлу базы данных. По умолчанию база данных создается в памяти.
+     */
+    void attach(const std::string& scheme, const std::string& path = ":memory:");
+
+    /**
+     * Создает таблицу по описанию, если она еще не существует. Схема подключается, если она еще не подключена.
+     * Столбец с настройками primary_key и auto_increment объявляется как INTEGER PRIMARY KEY.
+     *
+     * @param schema Описание таблицы.
+     * @param column_type Тип остальных столбцов, например NUMERIC. По умолчанию тип не указывается.
+     */
+    void create_table(const table& schema, const std::string& column_type = {});
+
+    /**
+     * Выполняет все запросы текста, например скрипт sql_script::sql(). Строки результатов пропускаются.
+     *
+     * @param sql Текст запросов.
+     * @return Количество строк, измененных запросами.
+     * @throw error Если запрос не выполнен. Предыдущие запросы текста остаются выполненными.
+     */
+    size_t execute(const std::string& sql);
+
+    /**
+     * Выполняет запросы и возвращает строки результатов.
+     *
+     * @param sql Текст запросов.
+     * @return Строки результатов всех запросов.
+     */
+    std::vector<row> query(const std::string& sql);
+
+    /**
+     * Выполняет запросы и передает строки результатов в функцию без накопления.
+     *
+     * @param sql Текст запросов.
+     * @param handler Функция, вызываемая для каждой строки.
+     * @return Количество строк результатов.
+     */
+    size_t query(const std::string& sql, const row_handler& handler);
+
+    /**
+     * Возвращает дескриптор базы данных для прямых вызовов SQLite.
+     * @return Дескриптор базы данных.
+     */
+    sqlite3* handle() const noexcept;
+
+private:
+    /**
+     * Выполняет запросы по очереди.
+     *
+     * @param sql Текст запросов.
+     * @param handler Функция для строк результатов либо nullptr.
+     * @return Количество строк результатов.
+     */
+    size_t run(const std::string& sql, const row_handler* handler);
+
+    /**
+     * Выбрасывает исключение с последней ошибкой базы данных.
+     */
+    [[noreturn]] void fail(int code, size_t offset) const;
+
+private:
+    sqlite3* _db = nullptr;
+};
+
+} // namespace sqlite
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace query_craft {
+
+/// Класс, собирающий несколько SQL-запросов в один скрипт для выполнения за один сетевой обмен.
+/// Запросы добавляются готовым текстом либо генерируются сразу в буфер скрипта через перегрузки вида insert_sql(std::string& out, ...).
+/// Для каждого запроса запоминается его позиция в скрипте, чтобы ошибку драйвера можно было сопоставить с запросом.
+/// Запросы разделяются переводом строки. Номер строки из сообщения об ошибке не совпадает с номером запроса,
+/// если текст запроса сам содержит перевод строки. Для сопоставления используйте смещение ошибки в скрипте
+/// и find_statement() либо смещения из statements().
+class sql_script
+{
+public:
+    /// Настройки скрипта.
+    struct settings
+    {
+        /// Обернуть скрипт в BEGIN / COMMIT.
+        bool transaction = false;
+
+        /// Максимальный размер скрипта в байтах вместе с BEGIN / COMMIT. 0 - без ограничения.
+        size_t max_size = 0;
+    };
+
+    /**
+     * @brief Вид запроса в скрипте.
+     */
+    enum class statement_kind : uint8_t
+    {
+        /// Запрос, добавленный через add или add_rendered.
+        statement,
+
+        /// Служебный запрос: BEGIN, COMMIT или работа с точками сохранения.
+        control
+    };
+
+    /// Позиция запроса в скрипте.
+    struct statement_info
+    {
+        /// Смещение первого символа запроса.
+        size_t offset = 0;
+
+        /// Длина запроса вместе с завершающей точкой с запятой.
+        size_t size = 0;
+
+        statement_kind kind = statement_kind::statement;
+    };
+
+    /// Значение, возвращаемое find_statement, если позиция не принадлежит ни одному запросу.
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+public:
+    sql_script();
+
+    /**
+     * Конструктор с указанием настроек.
+     *
+     * @param settings Настройки скрипта.
+     */
+    explicit sql_script(settings settings);
+
+    /**
+     * Добавляет готовый запрос. Если запрос не заканчивается точкой с запятой, она добавляется.
+     *
+     * @param statement Текст запроса.
+     * @return false, если запрос не помещается в ограничение размера. В этом случае скрипт не изменяется.
+     * @throw std::logic_error Если скрипт уже завершен вызовом sql().
+     */
+    bool add(const std::string& statement);
+
+    /**
+     * Добавляет запрос, генерируя его сразу в буфер скрипта без промежуточной строки.
+     *
+     * @param render Функция, добавляющая текст запроса в конец переданного буфера,
+     * например [&](std::string& out) { table.insert_sql(out); }.
+     * @return false, если запрос не помещается в ограничение размера. Текст запроса при этом доступен через rejected().
+     * @throw std::logic_error Если скрипт уже завершен вызовом sql().
+     */
+    template<class Render>
+    bool add_rendered(Render&& render)
+    {
+        const auto start = begin_statement();
+        render(_script);
+
+        return end_statement(start, statement_kind::statement);
+    }
+
+    /**
+     * Добавляет точку сохранения "SAVEPOINT name;".
+     *
+     * @param name Имя точки сохранения.
+     * @return false, если запрос не помещается в ограничение размера.
+     */
+    bool savepoint(const std::string& name);
+
+    /**
+     * Добавляет освобождение точки сохранения "RELEASE SAVEPOINT name;".
+     *
+     * @param name Имя точки сохранения.
+     * @return false, если запрос не помещается в ограничение размера.
+     */
+    bool release_savepoint(const std::string& name);
+
+    /**
+     * Добавляет откат к точке сохранения "ROLLBACK TO SAVEPOINT name;".
+     *
+     * @param name Имя точки сохранения.
+     * @return false, если запрос не помещается в ограничение размера.
+     */
+    bool rollback_to_savepoint(const std::string& name);
+
+    /**
+     * Завершает скрипт и возвращает его текст. При включенной транзакции добавляет COMMIT.
+     * После вызова добавлять запросы нельзя до вызова clear().
+     *
+     * @return Текст скрипта для выполнения одним запросом (simple query).
+     */
+    const std::string& sql();
+
+    /**
+     * Возвращает текст запроса скрипта, например для отправки запросов по отдельности в режиме конвейера (pipeline mode).
+     *
+     * @param index Номер запроса в statements().
+     * @return Текст запроса.
+     */
+    std::string statement_sql(size_t index) const;
+
+    /**
+     * Возвращает позиции всех запросов скрипта, включая служебные.
+     * @return Позиции запросов в порядке следования.
+     */
+    const std::vector<statement_info>& statements() const;
+
+    /**
+     * Находит запрос, содержащий указанную позицию скрипта, например позицию из сообщения об ошибке.
+     *
+     * @param position Смещение в скрипте.
+     * @return Номер запроса в statements() либо npos.
+     */
+    size_t find_statement(size_t position) const;
+
+    /**
+     * Возвращает текст последнего запроса, не поместившегося в ограничение размера.
+     * @return Текст запроса либо пустая строка.
+     */
+    const std::string& rejected() const;
+
+    /**
+     * Возвращает количество добавленных запросов без учета служебных.
+     * @return Количество запросов.
+     */
+    size_t size() const;
+
+    /**
+     * Проверяет, добавлены ли в скрипт запросы, не считая служебных.
+     * @return true, если запросов нет.
+     */
+    bool empty() const;
+
+    /**
+     * Удаляет все запросы, сохраняя выделенную память, и снимает завершение скрипта.
+     */
+    void clear();
+
+private:
+    /**
+     * Подготавливает буфер к добавлению запроса.
+     * @return Размер буфера до добавления.
+     */
+    size_t begin_statement();
+
+    /**
+     * Проверяет ограничение размера и запоминает позицию добавленного запроса.
+     *
+     * @param start Размер буфера до добавления.
+     * @param kind Вид запроса.
+     * @return false, если запрос не поместился и был удален из буфера.
+     */
+    bool end_statement(size_t start, statement_kind kind);
+
+    /**
+     * Добавляет служебный запрос.
+     */
+    bool add_control(const char* prefix, const std::string& name);
+
+    /**
+     * Возвращает размер, который добавит завершение скрипта.
+     */
+    size_t closing_size() const;
+
+private:
+    settings _settings {};
+
+    std::string _script;
+    std::string _rejected;
+    std::vector<statement_info> _statements;
+
+    /// Количество запросов без учета служебных.
+    size_t _count = 0;
+
+    /// Скрипт завершен вызовом sql().
+    bool _finished = false;
+};
+
+} // namespace query_craft
\ No newline at end of file
@@ -1,9 +1,14 @@
 #pragma once
 
+#include "arrayview.h"
 #include "helper/tuplehelper.h"
 #include "joincolumn.h"
 #include "sortcolumn.h"
 #include "table.h"
+#include "tablesample.h"
+
+#include <iterator>
+#include <type_traits>
 
 namespace query_craft {
 
@@ -81,6 +86,53 @@ public:
      */
     sql_table& add_row(const row& row);
 
+    /**
+     * Добавление строки в таблицу без копирования значений.
+     *
+     * @param row Строка для добавления.
+     * @return Ссылка на текущую таблицу.
+     */
+    sql_table& add_row(row&& row);
+
+    /**
+     * Добавление диапазона строк в таблицу.
+     * Для однонаправленных итераторов память под строки резервируется заранее,
+     * строки из std::move_iterator перемещаются.
+     *
+     * @param first Итератор начала диапазона строк.
+     * @param last Итератор конца диапазона строк.
+     * @return Ссылка на текущую таблицу.
+     * @note При ошибке в одной из строк предыдущие строки остаются добавленными
+     */
+    template<class InputIt>
+    sql_table& add_rows(InputIt first, InputIt last)
+    {
+        using category = typename std::iterator_traits<InputIt>::iterator_category;
+
+        if(std::is_base_of<std::forward_iterator_tag, category>::value)
+            rows.reserve(rows.size() + static_cast<size_t>(std::distance(first, last)));
+
+        for(; first != last; ++first)
+            add_row(*first);
+
+        return *this;
+    }
+
+    /**
+     * Добавление строки в таблицу с использованием переменного числа аргументов.
+     * Значения преобразуются сразу в строку таблицы без промежуточных копий.
+     *
+     * @param args Значения для добавления в качестве столбцов.
+     * @return Ссылка на текущую таблицу.
+     * @note Использует метод convertToString (по умолчанию использует оператор << для преобразования в строку),
+     * для изменения поведения нужно переопределить метод для своего типа
+     */
+    template<typename... Args>
+    sql_table& emplace_row(Args&&... args)
+    {
+        return add_row(make_row(std::forward<Args>(args)...));
+    }
+
     /**
      * Добавление строки в таблицу с использованием переменного числа аргументов.
      *
@@ -92,19 +144,25 @@ public:
     template<typename... Args>
     sql_table& add_row_args(Args&&... args)
     {
-        auto values = std::make_tuple<Args...>(std::forward<Args>(args)...);
+        return emplace_row(std::forward<Args>(args)...);
+    }
 
+    /**
+     * Преобразует значения в строку таблицы.
+     *
+     * @param args Значения столбцов.
+     * @return Строка таблицы с зарезервированной памятью под все значения.
+     */
+    template<typename... Args>
+    static row make_row(Args&&... args)
+    {
         row row;
+        row.reserve(sizeof...(Args));
 
-        helper::for_each(values, [&row](auto&& value) {
-            row.emplace_back(type_converter_api::type_converter<decltype(value)>().convert_to_string(value));
-        });
-
-        if(!rows.empty() && rows.begin()->size() != row.size())
-            throw std::logic_error("Ошибка. Не совпадает размер строки с уже добавленными в таблицу");
+        using expand = int[];
+        (void)expand { 0, (row.emplace_back(type_converter_api::type_converter<std::decay_t<Args>>().convert_to_string(args)), 0)... };
 
-        rows.push_back(row);
-        return *this;
+        return row;
     }
 
     /**
@@ -115,9 +173,9 @@ public:
      * @param returning_columns Колонки которые необходимо вернуть после вставкибцы.
      * @return SQL-запрос для вставки.
      * @note Очищает добавленные строки
-     * @note Перегрузка для передачи параметров через initializer_list, так как бывают ситуации когда он не может не явно кастануть к vector
+     * @note Сохранена для совместимости. Параметры принимают и vector, и initializer_list без копирования
      */
-    std::string insert_args(const std::initializer_list<column_info>& columns, bool need_returning = false, const std::initializer_list<column_info>& returning_columns = {});
+    std::string insert_args(array_view<column_info> columns, bool need_returning = false, array_view<column_info> returning_columns = {});
 
     /**
      * Генерация SQL-запроса для вставки строки в таблицу.
@@ -128,7 +186,18 @@ public:
      * @return SQL-запрос для вставки.
      * @note Очищает добавленные строки
      */
-    std::string insert_sql(const std::vector<column_info>& columns = {}, bool need_returning = false, const std::vector<column_info>& returning_columns = {});
+    std::string insert_sql(array_view<column_info> columns = {}, bool need_returning = false, array_view<column_info> returning_columns = {});
+
+    /**
+     * Генерация SQL-запроса для вставки строки в таблицу в конец переданного буфера.
+     *
+     * @param out Буфер, в конец которого добавляется запрос. Переиспользование буфера позволяет избежать выделения памяти.
+     * @param columns Столбцы для вставки. По умолчанию все столбцы.
+     * @param need_returning Флаг означающий что в конце запроса необходимо вернуть вставленные колонки
+     * @param returning_columns Колонки которые необходимо вернуть после вставки
+     * @note Очищает добавленные строки
+     */
+    void insert_sql(std::string& out, array_view<column_info> columns = {}, bool need_returning = false, array_view<column_info> returning_columns = {});
 
     /**
      * Генерация SQL-запроса для обновления строки в таблице.
@@ -137,9 +206,9 @@ public:
      * @param columns   Столбцы для обновления. По умолчанию все столбцы.
      * @return SQL-запрос для обновления.
      * @note Очищает добавленные строки
-     * @note Перегрузка для передачи параметров через initializer_list, так как бывают ситуации когда он не может не явно кастануть к vector
+     * @note Сохранена для совместимости. Параметры принимают и vector, и initializer_list без копирования
      */
-    std::string update_args_sql(const condition_group& condition = {}, const std::initializer_list<column_info>& columns = {});
+    std::string update_args_sql(const condition_group& condition = {}, array_view<column_info> columns = {});
 
     /**
      * Генерация SQL-запроса для обновления строки в таблице.
@@ -149,7 +218,110 @@ public:
      * @return SQL-запрос для обновления.
      * @note Очищает добавленные строки
      */
-    std::string update_sql(const condition_group& condition = {}, const std::vector<column_info>& columns = {});
+    std::string update_sql(const condition_group& condition = {}, array_view<column_info> columns = {});
+
+    /**
+     * Генерация SQL-запроса для обновления строки в таблице в конец переданного буфера.
+     *
+     * @param out Буфер, в конец которого добавляется запрос.
+     * @param condition Условие для выбора строки.
+     * @param columns   Столбцы для обновления. По умолчанию все столбцы.
+     * @note Очищает добавленные строки
+     */
+    void update_sql(std::string& out, const condition_group& condition = {}, array_view<column_info> columns = {});
+
+    /**
+     * Генерация SQL-запроса для обновления только тех столбцов, значения которых изменились.
+     * В PostgreSQL это позволяет выполнить HOT-обновление, если не изменились индексированные столбцы, и уменьшает объем WAL.
+     *
+     * @param old_row        Строка до изменения.
+     * @param new_row        Строка после изменения.
+     * @param condition      Условие для выбора строки.
+     * @param distinct_guard Добавить к условию проверку "column IS DISTINCT FROM value",
+     * чтобы запрос не изменял строки, в которых значения уже совпадают.
+     * @param columns        Столбцы строк. По умолчанию все столбцы.
+     * @return SQL-запрос для обновления либо пустая строка, если значения не изменились.
+     * @note Не использует добавленные через add_row строки
+     */
+    std::string diff_update_sql(const row& old_row,
+        const row& new_row,
+        const condition_group& condition = {},
+        bool distinct_guard = false,
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация SQL-запроса для обновления отмеченных столбцов.
+     *
+     * @param new_row        Новые значения всех столбцов.
+     * @param changed        Маска столбцов, которые нужно обновить.
+     * @param condition      Условие для выбора строки.
+     * @param distinct_guard Добавить к условию проверку "column IS DISTINCT FROM value".
+     * @param columns        Столбцы строки. По умолчанию все столбцы.
+     * @return SQL-запрос для обновления либо пустая строка, если ни один столбец не отмечен.
+     */
+    std::string masked_update_sql(const row& new_row,
+        const std::vector<bool>& changed,
+        const condition_group& condition = {},
+        bool distinct_guard = false,
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация SQL-запросов для обновления набора строк, идентифицируемых ключевым столбцом.
+     * Обновляются только измененные столбцы, строки с одинаковыми изменениями объединяются в один запрос "... WHERE key IN (...)".
+     *
+     * @param changes        Пары строк до и после изменения.
+     * @param key            Ключевой столбец. Значение ключа берется из строки до изменения.
+     * @param distinct_guard Добавить к условию проверку "column IS DISTINCT FROM value".
+     * @param columns        Столбцы строк. По умолчанию все столбцы. Должны содержать ключевой столбец.
+     * @return SQL-запросы. Строки без изменений пропускаются.
+     */
+    std::vector<std::string> diff_update_batch_sql(const std::vector<std::pair<row, row>>& changes,
+        const column_info& key,
+        bool distinct_guard = false,
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация SQL-запроса для вставки в текущую таблицу результата выборки из другой таблицы.
+     * Строки копируются на сервере и не передаются клиенту.
+     *
+     * @param target_columns Столбцы текущей таблицы для вставки. По умолчанию все столбцы.
+     * @param source         Таблица, из которой выбираются строки.
+     * @param join_columns   Информация о join соединениях
+     * @param condition      Условие для выбора строк.
+     * @param sort_columns   Информация о колонках необходимых для сортировок
+     * @param limit          Лимит выборки.
+     * @param offset         Смещение выборки.
+     * @param source_columns Столбцы для выборки. По умолчанию все столбцы source.
+     * @return SQL-запрос вида "INSERT INTO table (...) SELECT ... FROM source ...;".
+     * @note Не использует добавленные через add_row строки
+     */
+    std::string insert_from_select_sql(
+        array_view<column_info> target_columns,
+        const table& source,
+        array_view<join_column> join_columns = {},
+        const condition_group& condition = {},
+        array_view<sort_column> sort_columns = {},
+        size_t limit = 0,
+        size_t offset = 0,
+        array_view<column_info> source_columns = {}) const;
+
+    /**
+     * Генерация SQL-запроса для переноса строк из текущей таблицы в другую (например, в архив) одним запросом (PostgreSQL).
+     *
+     * @param target         Таблица, в которую переносятся строки.
+     * @param condition      Условие для выбора строк.
+     * @param columns        Переносимые столбцы текущей таблицы. По умолчанию все столбцы.
+     * @param target_columns Столбцы target. По умолчанию все столбцы target.
+     * @param batch_limit    Максимальное количество строк за один запрос. 0 - без ограничения.
+     * Требует единственного первичного ключа, так как DELETE не поддерживает LIMIT.
+     * @return SQL-запрос вида "WITH moved AS (DELETE FROM table ... RETURNING ...) INSERT INTO target (...) SELECT ... FROM moved;".
+     * @note Удаление и вставка выполняются в одном запросе, поэтому строки не теряются при ошибке вставки
+     */
+    std::string move_to_sql(const table& target,
+        const condition_group& condition = {},
+        array_view<column_info> columns = {},
+        array_view<column_info> target_columns = {},
+        size_t batch_limit = 0) const;
 
     /**
      * Генерация SQL-запроса для удаления строки из таблицы.
@@ -159,6 +331,14 @@ public:
      */
     std::string remove_sql(const condition_group& condition = {}) const;
 
+    /**
+     * Генерация SQL-запроса для удаления строки из таблицы в конец переданного буфера.
+     *
+     * @param out Буфер, в конец которого добавляется запрос.
+     * @param condition Условие для выбора строки.
+     */
+    void remove_sql(std::string& out, const condition_group& condition = {}) const;
+
     /**
      * Генерация SQL-запроса для выборки строк из таблицы.
      *
@@ -169,15 +349,15 @@ public:
      * @param offset        Смещение выборки.
      * @param columns       Столбцы для выборки. По умолчанию все столбцы.
      * @return SQL-запрос для выборки.
-     * @note Перегрузка для передачи параметров через initializer_list, так как бывают ситуации когда он не может не явно кастануть к vector
+     * @note Сохранена для совместимости. Параметры принимают и vector, и initializer_list без копирования
      */
     std::string select_args_sql(
-        const std::initializer_list<join_column>& join_columns = {},
+        array_view<join_column> join_columns = {},
         const condition_group& condition = {},
-        const std::initializer_list<sort_column>& sort_columns = {},
+        array_view<sort_column> sort_columns = {},
         size_t limit = 0,
         size_t offset = 0,
-        const std::initializer_list<column_info>& columns = {}) const;
+        array_view<column_info> columns = {}) const;
 
     /**
      * Генерация SQL-запроса для выборки строк из таблицы.
@@ -191,12 +371,160 @@ public:
      * @return SQL-запрос для выборки.
      */
     std::string select_sql(
-        const std::vector<join_column>& join_columns = {},
+        array_view<join_column> join_columns = {},
+        const condition_group& condition = {},
+        array_view<sort_column> sort_columns = {},
+        size_t limit = 0,
+        size_t offset = 0,
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация SQL-запроса для выборки строк из таблицы в конец переданного буфера.
+     *
+     * @param out           Буфер, в конец которого добавляется запрос.
+     * @param join_columns   Информация о join соединениях
+     * @param condition     Условие для выбора строк.
+     * @param sort_columns   Информация о колонках необходимых для сортировок
+     * @param limit         Лимит выборки.
+     * @param offset        Смещение выборки.
+     * @param columns       Столбцы для выборки. По умолчанию все столбцы.
+     */
+    void select_sql(
+        std::string& out,
+        array_view<join_column> join_columns = {},
+        const condition_group& condition = {},
+        array_view<sort_column> sort_columns = {},
+        size_t limit = 0,
+        size_t offset = 0,
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация вложенного запроса для выборки строк из таблицы.
+     * Результат можно использовать в условиях IN, NOT IN, EXISTS и NOT EXISTS.
+     *
+     * @param join_columns   Информация о join соединениях
+     * @param condition     Условие для выбора строк. Может ссылаться на столбцы внешнего запроса.
+     * @param sort_columns   Информация о колонках необходимых для сортировок
+     * @param limit         Лимит выборки.
+     * @param offset        Смещение выборки.
+     * @param columns       Столбцы для выборки. По умолчанию все столбцы.
+     * @return Вложенный запрос без завершающей точки с запятой.
+     */
+    sub_query sub_select(
+        array_view<join_column> join_columns = {},
+        const condition_group& condition = {},
+        array_view<sort_column> sort_columns = {},
+        size_t limit = 0,
+        size_t offset = 0,
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация SQL-запроса для выборки случайного подмножества строк через TABLESAMPLE (PostgreSQL).
+     *
+     * @param sample        Описание выборки.
+     * @param join_columns   Информация о join соединениях
+     * @param condition     Условие для выбора строк.
+     * @param sort_columns   Информация о колонках необходимых для сортировок
+     * @param limit         Лимит выборки.
+     * @param offset        Смещение выборки.
+     * @param columns       Столбцы для выборки. По умолчанию все столбцы.
+     * @return SQL-запрос для выборки.
+     * @note В отличие от random_sort() не сортирует всю таблицу.
+     */
+    std::string sample_select_sql(
+        const table_sample& sample,
+        array_view<join_column> join_columns = {},
         const condition_group& condition = {},
-        const std::vector<sort_column>& sort_columns = {},
+        array_view<sort_column> sort_columns = {},
         size_t limit = 0,
         size_t offset = 0,
-        const std::vector<column_info>& columns = {}) const;
+        array_view<column_info> columns = {}) const;
+
+    /**
+     * Генерация SQL-запроса для выборки случайных строк по случайным значениям ключа.
+     * Подходит для баз без TABLESAMPLE (например, SQLite): ключи выбираются на клиенте из диапазона [min_key, max_key]
+     * и ищутся по индексу, поэтому запрос не читает всю таблицу и не сортирует ее через ORDER BY RANDOM ().
+     *
+     * Запрос возвращает до count строк: ключи, попавшие в пропуски диапазона или не прошедшие condition, строк не дают.
+     * Если вызывающей стороне нужно ровно count строк, недостающие строки запрашиваются повторно с другим seed.
+     * Если запрашивается больше ключей, чем count, строки, оставляемые LIMIT, выбираются через ORDER BY RANDOM ()
+     * среди найденных строк (не больше count * oversampling), поэтому выборка не смещается к наименьшим ключам.
+     * Такой запрос не повторяется при одном seed.
+     *
+     * @param key          Целочисленный ключевой столбец (обычно первичный ключ).
+     * @param min_key      Минимальное значение ключа.
+     * @param max_key      Максимальное значение ключа.
+     * @param count        Требуемое количество строк.
+     * @param seed         Начальное значение генератора случайных ключей.
+     * @param condition    Дополнительное условие для выбора строк.
+     * @param columns      Столбцы для выборки. По умолчанию все столбцы.
+     * @param oversampling Во сколько раз больше ключей запрашивать, чтобы компенсировать пропуски в диапазоне.
+     * Не используется, если диапазон содержит не больше count * oversampling ключей.
+     * @return SQL-запрос для выборки не более count строк.
+     */
+    std::string random_keys_select_sql(
+        const column_info& key,
+        int64_t min_key,
+        int64_t max_key,
+        size_t count,
+        uint64_t seed,
+        const condition_group& condition = {},
+        array_view<column_info> columns = {},
+        double oversampling = 2.0) const;
+
+    /**
+     * Генерация SQL-запроса для проверки существования строк без выборки столбцов.
+     *
+     * @param join_columns Информация о join соединениях
+     * @param condition    Условие для выбора строк.
+     * @return SQL-запрос вида "SELECT EXISTS (SELECT 1 FROM ... WHERE ...);", возвращающий одно логическое значение.
+     */
+    std::string exists_sql(array_view<join_column> join_columns = {}, const condition_group& condition = {}) const;
+
+    /**
+     * Генерация SQL-запроса для подсчета строк без выборки столбцов.
+     *
+     * @param join_columns Информация о join соединениях
+     * @param condition    Условие для выбора строк.
+     * @return SQL-запрос вида "SELECT COUNT(*) FROM ... WHERE ...;".
+     */
+    std::string count_sql(array_view<join_column> join_columns = {}, const condition_group& condition = {}) const;
+
+    /**
+     * Генерация SQL-запроса для приблизительной оценки количества строк по статистике планировщика PostgreSQL.
+     *
+     * @param condition Условие для выбора строк.
+     * @return Без условия - запрос к pg_class.reltuples, возвращающий одно число.
+     * С условием - запрос EXPLAIN (FORMAT JSON), результат которого разбирается через parse_estimated_count.
+     * @note Оценка может сильно отличаться от точного значения, если статистика таблицы устарела.
+     */
+    std::string estimated_count_sql(const condition_group& condition = {}) const;
+
+    /**
+     * Извлекает оценку количества строк из результата запроса EXPLAIN (FORMAT JSON).
+     *
+     * @param explain_json Результат запроса, сгенерированного estimated_count_sql с условием.
+     * @return Оценка количества строк корневого узла плана.
+     */
+    static size_t parse_estimated_count(const std::string& explain_json);
+
+private:
+    /**
+     * Проверяет, что строку можно добавить к уже добавленным строкам.
+     *
+     * @param row Строка для добавления.
+     */
+    void check_row(const row& row) const;
+
+    /**
+     * Добавляет в буфер часть запроса " FROM table JOIN ... WHERE ...".
+     *
+     * @param out          Буфер.
+     * @param join_columns Информация о join соединениях
+     * @param condition    Условие для выбора строк.
+     * @param sample       Описание выборки TABLESAMPLE. nullptr, если выборка не нужна.
+     */
+    void append_from(std::string& out, array_view<join_column> join_columns, const condition_group& condition, const table_sample* sample = nullptr) const;
 
 private:
     /// Вектор, содержащий строки таблицы.
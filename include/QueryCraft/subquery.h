@@ -0,0 +1,36 @@
+#pragma once
+
+#include <string>
+
+namespace query_craft {
+
+/// Структура, представляющая вложенный запрос, который можно использовать внутри условий и других запросов.
+/// Хранит текст запроса без завершающей точки с запятой.
+struct sub_query
+{
+    sub_query() = default;
+
+    /**
+     * Конструктор с текстом запроса.
+     * @param sql Текст запроса. Завершающая точка с запятой отбрасывается.
+     */
+    explicit sub_query(std::string sql);
+
+    /**
+     * Возвращает текст запроса.
+     * @return Текст запроса без завершающей точки с запятой.
+     */
+    const std::string& sql() const;
+
+    /**
+     * Проверяет, задан ли запрос.
+     * @return true, если текст запроса не пуст, иначе false.
+     */
+    bool is_valid() const;
+
+private:
+    /// Текст запроса.
+    std::string _sql {};
+};
+
+} // namespace query_craft
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "arrayview.h"
 #include "conditiongroup.h"
 
 #include <unordered_map>
@@ -33,6 +34,7 @@ public:
     explicit table(std::string table_name, std::string scheme, Args&&... columns)
         : _scheme(std::move(scheme))
         , _table_name(std::move(table_name))
+        , _full_table_name(make_full_table_name(_scheme, _table_name))
     {
         auto columnList = { std::forward<Args>(columns)... };
         for(const column_info& column : columnList) {
@@ -53,6 +55,7 @@ public:
     explicit table(std::string table_name, std::string scheme, StartColumnIt&& startIt, EndColumnIt&& endIt)
         : _scheme(std::move(scheme))
         , _table_name(std::move(table_name))
+        , _full_table_name(make_full_table_name(_scheme, _table_name))
     {
         std::for_each(startIt, endIt, [this](const column_info& column) {
             column_info tempColumn(column);
@@ -81,7 +84,21 @@ public:
      *
      * @return Имя таблицы с названием схемы если она есть.
      */
-    std::string table_name() const;
+    const std::string& table_name() const;
+
+    /**
+     * Получение имени таблицы без схемы и кавычек.
+     *
+     * @return Имя таблицы.
+     */
+    const std::string& name() const;
+
+    /**
+     * Получение имени схемы таблицы.
+     *
+     * @return Имя схемы либо пустая строка.
+     */
+    const std::string& scheme() const;
 
     /**
      * Получение информации о столбце по его имени.
@@ -104,13 +121,25 @@ public:
      *
      * @return Список столбцов.
      */
-    std::vector<column_info> columns() const;
+    const std::vector<column_info>& columns() const;
+
+private:
+    /**
+     * Формирует полное имя таблицы.
+     *
+     * @param scheme Название схемы.
+     * @param table_name Название таблицы.
+     * @return Имя таблицы в кавычках с названием схемы если она есть.
+     */
+    static std::string make_full_table_name(const std::string& scheme, const std::string& table_name);
 
 protected:
     /// Название схемы таблицы.
     std::string _scheme {};
     /// Название таблицы.
     std::string _table_name {};
+    /// Полное имя таблицы. Вычисляется один раз, чтобы генерация запросов не собирала его заново.
+    std::string _full_table_name {};
     /// Список столбцов таблицы. Нужен для сохранения порядка при запросах.
     std::vector<column_info> _columns;
     /// Таблица столбцов. Нужна для быстрого поиска столбца по имени за O(1).
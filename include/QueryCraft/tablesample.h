@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+namespace query_craft {
+
+/// Структура, описывающая выборку случайного подмножества строк таблицы (TABLESAMPLE в PostgreSQL).
+/// В отличие от random_sort() не требует сортировки всей таблицы.
+struct table_sample
+{
+    /**
+     * @brief Методы выборки.
+     */
+    enum class method : uint8_t
+    {
+        /// Выборка случайных страниц таблицы (SYSTEM). Быстрая, но строки одной страницы попадают в выборку вместе.
+        system,
+
+        /// Выборка случайных строк (BERNOULLI). Читает всю таблицу, но каждая строка выбирается независимо.
+        bernoulli
+    };
+
+    method sample_method = method::system;
+
+    /// Доля строк в процентах, от 0 до 100.
+    double percent = 0;
+
+    /// Нужно ли фиксировать выборку через REPEATABLE (seed).
+    bool repeatable = false;
+
+    /// Начальное значение генератора для REPEATABLE.
+    int64_t seed = 0;
+};
+
+/**
+ * Создает выборку случайных страниц таблицы (TABLESAMPLE SYSTEM).
+ * @param percent Доля строк в процентах.
+ * @return Описание выборки.
+ */
+table_sample system_sample(double percent);
+
+/**
+ * Создает выборку случайных строк таблицы (TABLESAMPLE BERNOULLI).
+ * @param percent Доля строк в процентах.
+ * @return Описание выборки.
+ */
+table_sample bernoulli_sample(double percent);
+
+/**
+ * Возвращает копию выборки с фиксированным начальным значением генератора (REPEATABLE).
+ * @param sample Описание выборки.
+ * @param seed Начальное значение генератора.
+ * @return Описание выборки с REPEATABLE.
+ */
+table_sample repeatable(table_sample sample, int64_t seed);
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,551 @@
+#include "QueryCraft/binarycodec.h"
+
+#include "QueryCraft/operator/existsoperator.h"
+#include "QueryCraft/operator/isnotoperator.h"
+#include "QueryCraft/operator/isoperator.h"
+#include "QueryCraft/operator/likeoperator.h"
+#include "QueryCraft/operator/notexistsoperator.h"
+#include "QueryCraft/sqltable.h"
+
+#include <stdexcept>
+#include <unordered_map>
+
+namespace {
+
+using namespace query_craft;
+
+/// Вид закодированных данных.
+enum class payload : uint8_t
+{
+    condition = 1,
+    select = 2
+};
+
+/// Тип узла дерева условий.
+enum class node_tag : uint8_t
+{
+    empty = 0,
+    leaf = 1,
+    and_ = 2,
+    or_ = 3
+};
+
+/// Первые байты закодированных данных.
+constexpr char magic[] = { 'Q', 'C' };
+
+/// Ограничение глубины дерева при декодировании, чтобы поврежденные данные не переполнили стек.
+constexpr size_t max_depth = 10000;
+
+/// Ключ записанного столбца: набор имен, общий для копий столбца, и настройки.
+struct column_key
+{
+    const void* names;
+    uint8_t settings;
+
+    bool operator==(const column_key& rhs) const
+    {
+        return names == rhs.names && settings == rhs.settings;
+    }
+};
+
+struct column_key_hash
+{
+    size_t operator()(const column_key& key) const
+    {
+        return std::hash<const void*>()(key.names) * 31 + key.settings;
+    }
+};
+
+uint8_t settings_byte(const column_info& column)
+{
+    uint8_t settings = 0;
+    for(const auto flag : { column_settings::primary_key, column_settings::not_null, column_settings::auto_increment }) {
+        if(column.has_settings(flag))
+            settings |= static_cast<uint8_t>(flag);
+    }
+
+    return settings;
+}
+
+/// Последовательная запись с таблицей уже записанных столбцов.
+/// Повторно встречающийся столбец записывается номером, поэтому условие по одному столбцу не дублирует его имена.
+class writer
+{
+public:
+    explicit writer(std::string& out)
+        : _out(out)
+    {
+    }
+
+    void put_byte(const uint8_t value)
+    {
+        _out.push_back(static_cast<char>(value));
+    }
+
+    void put_varint(uint64_t value)
+    {
+        while(value >= 0x80) {
+            _out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+
+        _out.push_back(static_cast<char>(value));
+    }
+
+    void put_string(const std::string& value)
+    {
+        put_varint(value.size());
+        _out.append(value);
+    }
+
+    void put_column(const column_info& column)
+    {
+        const auto settings = settings_byte(column);
+
+        // 0 означает новый столбец, k - ссылку на k-й записанный столбец.
+        // Копии столбца находятся по общему набору имен, независимо созданные одинаковые столбцы записываются повторно
+        const column_key key { column.names_id(), settings };
+
+        // emplace создает узел до поиска, поэтому сначала выполняется поиск, чтобы повторный столбец не выделял память
+        const auto it = _columns.find(key);
+        if(it != _columns.end()) {
+            put_varint(it->second);
+            return;
+        }
+
+        _columns.emplace(key, _columns.size() + 1);
+        put_varint(0);
+
+        put_string(column.name());
+        put_string(column.full_name());
+        put_string(column.alias());
+
+        put_byte(settings);
+    }
+
+    void put_columns(const std::vector<column_info>& columns)
+    {
+        put_varint(columns.size());
+
+        for(const auto& column : columns)
+            put_column(column);
+    }
+
+    void put_header(const payload kind)
+    {
+        _out.append(magic, sizeof(magic));
+        put_byte(codec::format_version);
+        put_byte(static_cast<uint8_t>(kind));
+    }
+
+    void put_condition(const condition_group& node)
+    {
+        if(!node.is_valid()) {
+            put_byte(static_cast<uint8_t>(node_tag::empty));
+            return;
+        }
+
+        if(!node.is_leaf()) {
+            put_byte(static_cast<uint8_t>(node.group_operator() == logical_operator::and_ ? node_tag::and_ : node_tag::or_));
+
+            // Внутренний узел всегда содержит обе ветви, но пустые ветви кодируются явно
+            if(node.left() != nullptr) {
+                put_condition(*node.left());
+            } else {
+                put_byte(static_cast<uint8_t>(node_tag::empty));
+            }
+
+            if(node.right() != nullptr) {
+                put_condition(*node.right());
+            } else {
+                put_byte(static_cast<uint8_t>(node_tag::empty));
+            }
+
+            return;
+        }
+
+        const auto& leaf = node.leaf();
+        const auto& condition_operator = leaf.condition_operator();
+
+        if(condition_operator == nullptr || condition_operator->type() == operator_type::custom)
+            throw std::invalid_argument("Ошибка. Пользовательские операторы не поддерживаются двоичным форматом");
+
+        put_byte(static_cast<uint8_t>(node_tag::leaf));
+        put_byte(static_cast<uint8_t>(condition_operator->type()));
+        put_byte(leaf.need_forging() ? 1 : 0);
+
+        put_column(leaf.condition_column());
+        put_columns(leaf.row_columns());
+
+        const auto& values = leaf.values();
+        put_varint(values.size());
+
+        for(const auto& value : values)
+            put_string(value);
+    }
+
+    void put_table(const table& source)
+    {
+        put_string(source.scheme());
+        put_string(source.name());
+        put_columns(source.columns());
+    }
+
+private:
+    std::string& _out;
+
+    /// Номера записанных столбцов, начиная с 1.
+    std::unordered_map<column_key, size_t, column_key_hash> _columns;
+};
+
+/// Последовательное чтение закодированных данных без копирования буфера.
+class reader
+{
+public:
+    reader(const char* data, const size_t size)
+        : _position(data)
+        , _end(data + size)
+    {
+    }
+
+    uint8_t get_byte()
+    {
+        if(_position == _end)
+            fail();
+
+        return static_cast<uint8_t>(*_position++);
+    }
+
+    uint64_t get_varint()
+    {
+        uint64_t value = 0;
+
+        for(unsigned shift = 0; shift < 64; shift += 7) {
+            const auto byte = get_byte();
+            value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+            if((byte & 0x80) == 0)
+                return value;
+        }
+
+        fail();
+        return 0;
+    }
+
+    size_t get_size()
+    {
+        const auto value = get_varint();
+
+        // Каждый элемент занимает хотя бы один байт, поэтому размер не может превышать остаток данных
+        if(value > static_cast<uint64_t>(_end - _position))
+            fail();
+
+        return static_cast<size_t>(value);
+    }
+
+    std::string get_string()
+    {
+        const auto size = get_size();
+        std::string value(_position, size);
+        _position += size;
+
+        return value;
+    }
+
+    column_info get_column()
+    {
+        const auto reference = get_varint();
+
+        if(reference != 0) {
+            if(reference > _columns.size())
+                fail();
+
+            return _columns[static_cast<size_t>(reference - 1)];
+        }
+
+        auto name = get_string();
+        auto full_name = get_string();
+        auto alias = get_string();
+        const auto settings = get_byte();
+
+        column_info column(std::move(name), static_cast<column_settings>(settings));
+        column.set_names(full_name, alias);
+
+        _columns.push_back(column);
+
+        return column;
+    }
+
+    std::vector<column_info> get_columns()
+    {
+        std::vector<column_info> columns(get_size());
+
+        for(auto& column : columns)
+            column = get_column();
+
+        return columns;
+    }
+
+    void get_header(const payload kind)
+    {
+        if(get_byte() != static_cast<uint8_t>(magic[0]) || get_byte() != static_cast<uint8_t>(magic[1]))
+            fail();
+
+        const auto version = get_byte();
+        if(version == 0 || version > codec::format_version)
+            throw std::invalid_argument("Ошибка. Неподдерживаемая версия двоичного формата");
+
+        if(get_byte() != static_cast<uint8_t>(kind))
+            fail();
+    }
+
+    condition_group get_condition(const size_t depth = 0)
+    {
+        if(depth > max_depth)
+            fail();
+
+        const auto tag = static_cast<node_tag>(get_byte());
+
+        switch(tag) {
+            case node_tag::empty:
+                return {};
+
+            case node_tag::and_:
+            case node_tag::or_: {
+                const auto left = get_condition(depth + 1);
+                const auto right = get_condition(depth + 1);
+
+                return tag == node_tag::and_ ? left && right : left || right;
+            }
+
+            case node_tag::leaf:
+                return get_leaf();
+
+            default:
+                fail();
+        }
+
+        return {};
+    }
+
+    table get_table()
+    {
+        auto scheme = get_string();
+        auto name = get_string();
+        const auto columns = get_columns();
+
+        return table(std::move(name), std::move(scheme), columns.begin(), columns.end());
+    }
+
+    void expect_end() const
+    {
+        if(_position != _end)
+            fail();
+    }
+
+    [[noreturn]] static void fail()
+    {
+        throw std::invalid_argument("Ошибка. Некорректные двоичные данные");
+    }
+
+private:
+    condition_info get_leaf()
+    {
+        const auto type = static_cast<operator_type>(get_byte());
+        const auto need_forging = get_byte() != 0;
+
+        auto column = get_column();
+        auto row_columns = get_columns();
+
+        condition_info::value_list values;
+
+        const auto count = get_size();
+        values.reserve(count);
+
+        for(size_t i = 0; i < count; i++)
+            values.push_back(get_string());
+
+        if(!row_columns.empty()) {
+            if(type != operator_type::in)
+                fail();
+
+            return condition_info::row_in(std::move(row_columns), std::move(values));
+        }
+
+        return condition_info::create(make_operator(type), std::move(column), std::move(values), need_forging);
+    }
+
+    static std::shared_ptr<operators::IOperator> make_operator(const operator_type type)
+    {
+        switch(type) {
+            case operator_type::equals:
+                return operators::shared_instance<operators::equals_operator>();
+            case operator_type::not_equals:
+                return operators::shared_instance<operators::not_equals_operator>();
+            case operator_type::less:
+                return operators::shared_instance<operators::less_operator>();
+            case operator_type::less_or_equals:
+                return operators::shared_instance<operators::less_or_equals_operator>();
+            case operator_type::more:
+                return operators::shared_instance<operators::more_operator>();
+            case operator_type::more_or_equals:
+                return operators::shared_instance<operators::more_or_equals_operator>();
+            case operator_type::in:
+                return operators::shared_instance<operators::in_operator>();
+            case operator_type::not_in:
+                return operators::shared_instance<operators::not_in_operator>();
+            case operator_type::like:
+                return operators::shared_instance<operators::like_operator>();
+            case operator_type::is:
+                return operators::shared_instance<operators::is_operator>();
+            case operator_type::is_not:
+                return operators::shared_instance<operators::is_not_operator>();
+            case operator_type::exists:
+                return operators::shared_instance<operators::exists_operator>();
+            case operator_type::not_exists:
+                return operators::shared_instance<operators::not_exists_operator>();
+            default:
+                fail();
+        }
+
+        return nullptr;
+    }
+
+private:
+    const char* _position;
+    const char* _end;
+
+    /// Прочитанные столбцы для разрешения ссылок.
+    std::vector<column_info> _columns;
+};
+
+} // namespace
+
+namespace query_craft {
+
+std::string select_sql(const select_description& description)
+{
+    return sql_table(description.source).select_sql(description.joins,
+        description.condition,
+        description.sorts,
+        description.limit,
+        description.offset,
+        description.columns);
+}
+
+namespace codec {
+
+void encode(std::string& out, const condition_group& condition)
+{
+    writer output(out);
+
+    output.put_header(payload::condition);
+    output.put_condition(condition);
+}
+
+std::string encode(const condition_group& condition)
+{
+    std::string out;
+    encode(out, condition);
+
+    return out;
+}
+
+void encode(std::string& out, const select_description& description)
+{
+    writer output(out);
+
+    output.put_header(payload::select);
+    output.put_table(description.source);
+
+    output.put_varint(description.joins.size());
+    for(const auto& join : description.joins) {
+        output.put_byte(static_cast<uint8_t>(join.join_type));
+        output.put_table(join.joined_table);
+        output.put_condition(join.condition);
+    }
+
+    output.put_condition(description.condition);
+
+    output.put_varint(description.sorts.size());
+    for(const auto& sort : description.sorts) {
+        output.put_byte(static_cast<uint8_t>(sort.sort_type));
+        output.put_column(sort.column);
+    }
+
+    output.put_varint(description.limit);
+    output.put_varint(description.offset);
+    output.put_columns(description.columns);
+}
+
+std::string encode(const select_description& description)
+{
+    std::string out;
+    encode(out, description);
+
+    return out;
+}
+
+condition_group decode_condition(const char* data, const size_t size)
+{
+    reader input(data, size);
+
+    input.get_header(payload::condition);
+    auto condition = input.get_condition();
+    input.expect_end();
+
+    return condition;
+}
+
+condition_group decode_condition(const std::string& data)
+{
+    return decode_condition(data.data(), data.size());
+}
+
+select_description decode_select(const char* data, const size_t size)
+{
+    reader input(data, size);
+    select_description description;
+
+    input.get_header(payload::select);
+    description.source = input.get_table();
+
+    description.joins.resize(input.get_size());
+    for(auto& join : description.joins) {
+        const auto join_type = input.get_byte();
+        if(join_type > static_cast<uint8_t>(join_column::type::cross))
+            reader::fail();
+
+        join.join_type = static_cast<join_column::type>(join_type);
+        join.joined_table = input.get_table();
+        join.condition = input.get_condition();
+    }
+
+    description.condition = input.get_condition();
+
+    description.sorts.resize(input.get_size());
+    for(auto& sort : description.sorts) {
+        const auto sort_type = input.get_byte();
+        if(sort_type > static_cast<uint8_t>(sort_column::type::desc))
+            reader::fail();
+
+        sort.sort_type = static_cast<sort_column::type>(sort_type);
+        sort.column = input.get_column();
+    }
+
+    description.limit = static_cast<size_t>(input.get_varint());
+    description.offset = static_cast<size_t>(input.get_varint());
+    description.columns = input.get_columns();
+
+    input.expect_end();
+
+    return description;
+}
+
+select_description decode_select(const std::string& data)
+{
+    return decode_select(data.data(), data.size());
+}
+
+} // namespace codec
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,75 @@
+#include "QueryCraft/commontableexpression.h"
+
+#include <algorithm>
+
+namespace query_craft {
+
+common_table_expression cte(const table& cte_table, sub_query query)
+{
+    if(!query.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой запрос общего табличного выражения");
+
+    return common_table_expression { cte_table, std::move(query), false };
+}
+
+common_table_expression recursive_cte(const table& cte_table, const sub_query& anchor, const sub_query& recursive_part, const bool union_all)
+{
+    if(!anchor.is_valid() || !recursive_part.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой запрос общего табличного выражения");
+
+    std::string query;
+    query.append(anchor.sql())
+        .append(union_all ? " UNION ALL " : " UNION ")
+        .append(recursive_part.sql());
+
+    return common_table_expression { cte_table, sub_query(std::move(query)), true };
+}
+
+void with_sql(std::string& out, const std::vector<common_table_expression>& expressions, const std::string& statement)
+{
+    if(expressions.empty()) {
+        out.append(statement);
+        return;
+    }
+
+    const auto recursive = std::any_of(expressions.begin(), expressions.end(), [](const common_table_expression& expression) {
+        return expression.recursive;
+    });
+
+    out.append(recursive ? "WITH RECURSIVE " : "WITH ");
+
+    for(auto it = expressions.begin(); it != expressions.end(); ++it) {
+        if(it != expressions.begin())
+            out.append(", ");
+
+        out.append(it->cte_table.table_name());
+
+        const auto& columns = it->cte_table.columns();
+        if(!columns.empty()) {
+            out.append(" (");
+
+            for(auto column = columns.begin(); column != columns.end(); ++column) {
+                if(column != columns.begin())
+                    out.append(", ");
+
+                out.append("\"").append(column->name()).append("\"");
+            }
+
+            out.append(")");
+        }
+
+        out.append(" AS (").append(it->query.sql()).append(")");
+    }
+
+    out.append(" ").append(statement);
+}
+
+std::string with_sql(const std::vector<common_table_expression>& expressions, const std::string& statement)
+{
+    std::string sql;
+    with_sql(sql, expressions, statement);
+
+    return sql;
+}
+
+} // namespace query_craft
\ No newline at end of file
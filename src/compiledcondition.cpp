@@ -0,0 +1,435 @@
+#include "QueryCraft/compiledcondition.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <utility>
+
+namespace {
+
+bool parse_number(const std::string& text, double& number)
+{
+    if(text.empty())
+        return false;
+
+    // strtod принимает "inf", "nan" и шестнадцатеричную запись, которые не являются числами в SQL
+    const auto first = text.front();
+    if(!(first >= '0' && first <= '9') && first != '-' && first != '+' && first != '.')
+        return false;
+
+    if(text.find_first_of("xX") != std::string::npos)
+        return false;
+
+    char* end = nullptr;
+    number = std::strtod(text.c_str(), &end);
+
+    return end == text.c_str() + text.size();
+}
+
+size_t next_char(const std::string& value, size_t position)
+{
+    position++;
+
+    // Пропуск байтов продолжения UTF-8
+    while(position < value.size() && (static_cast<unsigned char>(value[position]) & 0xC0) == 0x80)
+        position++;
+
+    return position;
+}
+
+/// Приводит латинскую букву к нижнему регистру. Остальные символы, как и в SQLite, не изменяются.
+char fold_case(const char ch)
+{
+    return ch >= 'A' && ch <= 'Z' ? static_cast<char>(ch - 'A' + 'a') : ch;
+}
+
+} // namespace
+
+namespace query_craft {
+
+constexpr size_t compiled_condition::npos;
+
+compiled_condition::settings compiled_condition::sqlite_settings()
+{
+    settings result;
+    result.like_escape = '\0';
+    result.case_sensitive_like = false;
+    result.numbers_before_text = true;
+
+    return result;
+}
+
+compiled_condition::compiled_condition(const condition_group& condition, const table& schema)
+    : compiled_condition(condition, schema, settings())
+{
+}
+
+compiled_condition::compiled_condition(const condition_group& condition, const table& schema, settings settings)
+    : _column_count(schema.columns().size())
+    , _numeric_columns(schema.columns().size(), false)
+    , _settings(std::move(settings))
+{
+    const auto& columns = schema.columns();
+
+    for(const auto& name : _settings.numeric_columns) {
+        const auto it = std::find_if(columns.begin(), columns.end(), [&name](const column_info& column) {
+            return column.name() == name;
+        });
+
+        if(it == columns.end())
+            throw std::invalid_argument("Ошибка. Числовой столбец отсутствует в таблице");
+
+        _numeric_columns[static_cast<size_t>(it - columns.begin())] = true;
+    }
+
+    if(condition.is_valid())
+        compile(condition, schema);
+}
+
+bool compiled_condition::matches(const row& row) const
+{
+    if(_instructions.empty())
+        return true;
+
+    if(row.size() != _column_count)
+        throw std::logic_error("Ошибка. Не совпадает размер строки с количеством колонок");
+
+    const auto getter = [&row](const size_t index) -> const std::string& {
+        return row[index];
+    };
+
+    return evaluate(0, getter) == truth::true_;
+}
+
+bool compiled_condition::matches(const value_accessor& accessor) const
+{
+    if(_instructions.empty())
+        return true;
+
+    return evaluate(0, accessor) == truth::true_;
+}
+
+std::vector<compiled_condition::row> compiled_condition::filter(const std::vector<row>& rows) const
+{
+    std::vector<row> result;
+
+    for(const auto& row : rows) {
+        if(matches(row))
+            result.push_back(row);
+    }
+
+    return result;
+}
+
+size_t compiled_condition::size() const
+{
+    return _instructions.size();
+}
+
+void compiled_condition::compile(const condition_group& node, const table& schema)
+{
+    if(node.is_leaf()) {
+        compile_leaf(node.leaf(), schema);
+        return;
+    }
+
+    if(node.left() == nullptr || node.right() == nullptr)
+        throw std::invalid_argument("Ошибка. Некорректное дерево условий");
+
+    const auto index = _instructions.size();
+
+    instruction group;
+    group.code = node.group_operator() == logical_operator::and_ ? opcode::and_ : opcode::or_;
+    _instructions.push_back(group);
+
+    compile(*node.left(), schema);
+
+    _instructions[index].first_operand = _instructions.size();
+
+    compile(*node.right(), schema);
+}
+
+void compiled_condition::compile_leaf(const condition_group::condition& leaf, const table& schema)
+{
+    const auto find_column = [&schema](const std::string& full_name, const std::string& name) {
+        const auto& columns = schema.columns();
+
+        for(size_t i = 0; i < columns.size(); i++) {
+            if(columns[i].full_name() == full_name)
+                return i;
+        }
+
+        for(size_t i = 0; i < columns.size(); i++) {
+            if(full_name.empty() && columns[i].name() == name)
+                return i;
+        }
+
+        return npos;
+    };
+
+    const auto& condition_operator = leaf.condition_operator();
+    if(condition_operator == nullptr)
+        throw std::invalid_argument("Ошибка. Условие не содержит оператора");
+
+    if(!leaf.row_columns().empty())
+        throw std::invalid_argument("Ошибка. Условия по составному ключу не поддерживаются при проверке строк в памяти");
+
+    const auto& leaf_column = leaf.condition_column();
+
+    instruction current;
+    current.column = find_column(leaf_column.full_name(), leaf_column.name());
+
+    if(current.column == npos)
+        throw std::invalid_argument("Ошибка. Условие ссылается на столбец, отсутствующий в таблице");
+
+    current.numeric = _numeric_columns[current.column];
+
+    const auto& values = leaf.values();
+
+    switch(condition_operator->type()) {
+        case operator_type::equals:
+            current.code = opcode::equals;
+            break;
+        case operator_type::not_equals:
+            current.code = opcode::not_equals;
+            break;
+        case operator_type::less:
+            current.code = opcode::less;
+            break;
+        case operator_type::less_or_equals:
+            current.code = opcode::less_or_equals;
+            break;
+        case operator_type::more:
+            current.code = opcode::more;
+            break;
+        case operator_type::more_or_equals:
+            current.code = opcode::more_or_equals;
+            break;
+        case operator_type::in:
+            current.code = opcode::in;
+            break;
+        case operator_type::not_in:
+            current.code = opcode::not_in;
+            break;
+        case operator_type::like:
+            current.code = opcode::like;
+            break;
+        case operator_type::is:
+        case operator_type::is_not: {
+            if(values.size() != 1 || values.front() != column_info::null_value())
+                throw std::invalid_argument("Ошибка. Оператор IS поддерживается только для NULL");
+
+            current.code = condition_operator->type() == operator_type::is ? opcode::is_null : opcode::is_not_null;
+            _instructions.push_back(current);
+            return;
+        }
+        default:
+            throw std::invalid_argument("Ошибка. Оператор не поддерживается при проверке строк в памяти");
+    }
+
+    current.first_operand = _operands.size();
+    current.operand_count = values.size();
+
+    for(const auto& value : values) {
+        if(leaf.need_forging()) {
+            _operands.push_back(make_operand(value));
+            continue;
+        }
+
+        // Значения без экранирования являются ссылками на столбцы либо вложенными запросами
+        operand reference;
+        reference.column = find_column(value, {});
+
+        if(reference.column == npos)
+            throw std::invalid_argument("Ошибка. Вложенные запросы не поддерживаются при проверке строк в памяти");
+
+        _operands.push_back(std::move(reference));
+    }
+
+    _instructions.push_back(current);
+}
+
+template<typename Getter>
+compiled_condition::truth compiled_condition::evaluate(const size_t index, const Getter& getter) const
+{
+    const auto& current = _instructions[index];
+
+    switch(current.code) {
+        case opcode::and_: {
+            const auto left = evaluate(index + 1, getter);
+            if(left == truth::false_)
+                return truth::false_;
+
+            const auto right = evaluate(current.first_operand, getter);
+            if(right == truth::false_)
+                return truth::false_;
+
+            return left == truth::true_ && right == truth::true_ ? truth::true_ : truth::unknown;
+        }
+
+        case opcode::or_: {
+            const auto left = evaluate(index + 1, getter);
+            if(left == truth::true_)
+                return truth::true_;
+
+            const auto right = evaluate(current.first_operand, getter);
+            if(right == truth::true_)
+                return truth::true_;
+
+            return left == truth::false_ && right == truth::false_ ? truth::false_ : truth::unknown;
+        }
+
+        case opcode::is_null:
+            return getter(current.column) == column_info::null_value() ? truth::true_ : truth::false_;
+
+        case opcode::is_not_null:
+            return getter(current.column) != column_info::null_value() ? truth::true_ : truth::false_;
+
+        default:
+            break;
+    }
+
+    const auto& value = getter(current.column);
+    if(value == column_info::null_value())
+        return truth::unknown;
+
+    bool has_null = false;
+    bool has_match = false;
+
+    for(size_t i = current.first_operand; i < current.first_operand + current.operand_count; i++) {
+        const auto& operand_value = _operands[i];
+        const auto& operand_text = operand_value.column == npos ? operand_value.text : getter(operand_value.column);
+
+        if(operand_value.is_null || (operand_value.column != npos && operand_text == column_info::null_value())) {
+            has_null = true;
+            continue;
+        }
+
+        switch(current.code) {
+            case opcode::like:
+                has_match = like(value, operand_text);
+                break;
+            case opcode::equals:
+            case opcode::in:
+            case opcode::not_in:
+                has_match = compare(value, operand_value, operand_text, current.numeric) == 0;
+                break;
+            case opcode::not_equals:
+                has_match = compare(value, operand_value, operand_text, current.numeric) != 0;
+                break;
+            case opcode::less:
+                has_match = compare(value, operand_value, operand_text, current.numeric) < 0;
+                break;
+            case opcode::less_or_equals:
+                has_match = compare(value, operand_value, operand_text, current.numeric) <= 0;
+                break;
+            case opcode::more:
+                has_match = compare(value, operand_value, operand_text, current.numeric) > 0;
+                break;
+            case opcode::more_or_equals:
+                has_match = compare(value, operand_value, operand_text, current.numeric) >= 0;
+                break;
+            default:
+                break;
+        }
+
+        if(has_match)
+            break;
+    }
+
+    if(current.code == opcode::not_in) {
+        if(has_match)
+            return truth::false_;
+
+        return has_null ? truth::unknown : truth::true_;
+    }
+
+    if(has_match)
+        return truth::true_;
+
+    return has_null ? truth::unknown : truth::false_;
+}
+
+int compiled_condition::compare(const std::string& value, const operand& operand_value, const std::string& operand_text, const bool numeric) const
+{
+    if(!numeric)
+        return value.compare(operand_text);
+
+    double number = 0;
+    const auto is_number = parse_number(value, number);
+
+    double other = operand_value.number;
+    const auto other_is_number = operand_value.column == npos ? operand_value.is_number : parse_number(operand_text, other);
+
+    if(is_number && other_is_number)
+        return number < other ? -1 : (number > other ? 1 : 0);
+
+    if(_settings.numbers_before_text && is_number != other_is_number)
+        return is_number ? -1 : 1;
+
+    return value.compare(operand_text);
+}
+
+bool compiled_condition::like(const std::string& value, const std::string& pattern) const
+{
+    const auto escape = _settings.like_escape;
+    const auto case_sensitive = _settings.case_sensitive_like;
+
+    size_t value_pos = 0;
+    size_t pattern_pos = 0;
+
+    // Позиции после последнего '%' для возврата при несовпадении
+    auto star_pattern = npos;
+    size_t star_value = 0;
+
+    while(value_pos < value.size()) {
+        if(pattern_pos < pattern.size()) {
+            const auto ch = pattern[pattern_pos];
+
+            if(ch == '%') {
+                star_pattern = ++pattern_pos;
+                star_value = value_pos;
+                continue;
+            }
+
+            if(ch == '_') {
+                value_pos = next_char(value, value_pos);
+                pattern_pos++;
+                continue;
+            }
+
+            const auto escaped = escape != '\0' && ch == escape && pattern_pos + 1 < pattern.size();
+            const auto literal = escaped ? pattern[pattern_pos + 1] : ch;
+
+            if(value[value_pos] == literal || (!case_sensitive && fold_case(value[value_pos]) == fold_case(literal))) {
+                value_pos++;
+                pattern_pos += escaped ? 2 : 1;
+                continue;
+            }
+        }
+
+        if(star_pattern == npos)
+            return false;
+
+        star_value = next_char(value, star_value);
+        value_pos = star_value;
+        pattern_pos = star_pattern;
+    }
+
+    while(pattern_pos < pattern.size() && pattern[pattern_pos] == '%')
+        pattern_pos++;
+
+    return pattern_pos == pattern.size();
+}
+
+compiled_condition::operand compiled_condition::make_operand(std::string text)
+{
+    operand result;
+
+    result.is_null = text == column_info::null_value();
+    result.is_number = !result.is_null && parse_number(text, result.number);
+    result.text = std::move(text);
+
+    return result;
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -1,23 +1,49 @@
 #include "QueryCraft/conditiongroup.h"
 
+#include "QueryCraft/operator/existsoperator.h"
 #include "QueryCraft/operator/isnotoperator.h"
 #include "QueryCraft/operator/isoperator.h"
 #include "QueryCraft/operator/likeoperator.h"
+#include "QueryCraft/operator/notexistsoperator.h"
+
+#include <memory>
+#include <mutex>
 
 namespace query_craft {
 
+struct condition_group::condition::column::symbol
+{
+    std::string name;
+    std::string full_name;
+    std::string alias;
+};
+
+namespace {
+
+const std::string& empty_name()
+{
+    static const std::string empty;
+    return empty;
+}
+
+} // namespace
+
 condition_group::condition::column::column(std::string name, const settings settings)
-    : _name(std::move(name))
+    : _symbol(name.empty() ? nullptr : std::make_shared<const symbol>(symbol { std::move(name), {}, {} }))
     , _columnSettings(settings)
 {
 }
 
 bool condition_group::condition::column::operator==(const column& rhs) const
 {
-    return _name == rhs._name
-        && _fullName == rhs._fullName
-        && _alias == rhs._alias
-        && _columnSettings == rhs._columnSettings;
+    if(_columnSettings != rhs._columnSettings)
+        return false;
+
+    // Копии одного столбца разделяют набор имен, строки сравниваются только для независимо созданных столбцов
+    if(_symbol == rhs._symbol)
+        return true;
+
+    return name() == rhs.name() && full_name() == rhs.full_name() && alias() == rhs.alias();
 }
 
 bool condition_group::condition::column::operator!=(const column& rhs) const
@@ -25,29 +51,45 @@ bool condition_group::condition::column::operator!=(const column& rhs) const
     return !(*this == rhs);
 }
 
-std::string condition_group::condition::column::name() const
+const std::string& condition_group::condition::column::name() const
 {
-    return _name;
+    return _symbol != nullptr ? _symbol->name : empty_name();
 }
 
-std::string condition_group::condition::column::full_name() const
+const std::string& condition_group::condition::column::full_name() const
 {
-    return _fullName;
+    return _symbol != nullptr ? _symbol->full_name : empty_name();
 }
 
 void condition_group::condition::column::set_full_name(const std::string& fullName)
 {
-    _fullName = fullName;
+    set_names(fullName, alias());
 }
 
-std::string condition_group::condition::column::alias() const
+const std::string& condition_group::condition::column::alias() const
 {
-    return _alias;
+    return _symbol != nullptr ? _symbol->alias : empty_name();
 }
 
 void condition_group::condition::column::set_alias(const std::string& alias)
 {
-    _alias = alias;
+    set_names(full_name(), alias);
+}
+
+void condition_group::condition::column::set_names(const std::string& fullName, const std::string& alias)
+{
+    if(name().empty() && fullName.empty() && alias.empty()) {
+        _symbol = nullptr;
+        return;
+    }
+
+    // Набор имен неизменяем, поскольку разделяется копиями столбца, поэтому создается новый набор
+    _symbol = std::make_shared<const symbol>(symbol { name(), fullName, alias });
+}
+
+const void* condition_group::condition::column::names_id() const
+{
+    return _symbol.get();
 }
 
 void condition_group::condition::column::add_settings(const settings settings)
@@ -62,55 +104,71 @@ bool condition_group::condition::column::has_settings(const settings settings) c
 
 condition_group::condition condition_group::condition::column::is_null() const
 {
-    return create_condition(std::move(std::make_shared<operators::is_operator>()), { null_value() });
+    return create_condition(operators::shared_instance<operators::is_operator>(), { null_value() });
 }
 
 condition_group::condition condition_group::condition::column::not_null() const
 {
-    return create_condition(std::move(std::make_shared<operators::is_not_operator>()), { null_value() });
+    return create_condition(operators::shared_instance<operators::is_not_operator>(), { null_value() });
 }
 
 condition_group::condition condition_group::condition::column::like(const std::string& pattern) const
 {
-    return create_condition(std::move(std::make_shared<operators::like_operator>()), { pattern });
+    return create_condition(operators::shared_instance<operators::like_operator>(), { pattern });
+}
+
+condition_group::condition condition_group::condition::column::in(sub_query query) const
+{
+    if(!query.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой вложенный запрос");
+
+    return create_condition(operators::shared_instance<operators::in_operator>(), { query.sql() }, false);
+}
+
+condition_group::condition condition_group::condition::column::not_in(sub_query query) const
+{
+    if(!query.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой вложенный запрос");
+
+    return create_condition(operators::shared_instance<operators::not_in_operator>(), { query.sql() }, false);
 }
 
 condition_group::condition condition_group::condition::column::equals(const column& value) const
 {
-    return create_condition(std::make_shared<operators::equals_operator>(), { value.full_name() }, false);
+    return create_condition(operators::shared_instance<operators::equals_operator>(), { value.full_name() }, false);
 }
 
 condition_group::condition condition_group::condition::column::not_equals(const column& value) const
 {
-    return create_condition(std::make_shared<operators::not_equals_operator>(), { value.full_name() }, false);
+    return create_condition(operators::shared_instance<operators::not_equals_operator>(), { value.full_name() }, false);
 }
 
 condition_group::condition condition_group::condition::column::less(const column& value) const
 {
-    return create_condition(std::make_shared<operators::less_operator>(), { value.full_name() }, false);
+    return create_condition(operators::shared_instance<operators::less_operator>(), { value.full_name() }, false);
 }
 
 condition_group::condition condition_group::condition::column::less_or_equals(const column& value) const
 {
-    return create_condition(std::make_shared<operators::less_or_equals_operator>(), { value.full_name() }, false);
+    return create_condition(operators::shared_instance<operators::less_or_equals_operator>(), { value.full_name() }, false);
 }
 
 condition_group::condition condition_group::condition::column::more(const column& value) const
 {
-    return create_condition(std::make_shared<operators::more_operator>(), { value.full_name() }, false);
+    return create_condition(operators::shared_instance<operators::more_operator>(), { value.full_name() }, false);
 }
 
 condition_group::condition condition_group::condition::column::more_or_equals(const column& value) const
 {
-    return create_condition(std::make_shared<operators::more_or_equals_operator>(), { value.full_name() }, false);
+    return create_condition(operators::shared_instance<operators::more_or_equals_operator>(), { value.full_name() }, false);
 }
 
 bool condition_group::condition::column::is_valid() const
 {
-    return !_name.empty() || !_fullName.empty() || !_alias.empty() || _columnSettings != settings::none;
+    return _symbol != nullptr || _columnSettings != settings::none;
 }
 
-condition_group::condition condition_group::condition::column::create_condition(std::shared_ptr<operators::IOperator>&& conditionOperator, std::vector<std::string>&& values, bool need_forging) const
+condition_group::condition condition_group::condition::column::create_condition(std::shared_ptr<operators::IOperator>&& conditionOperator, value_list&& values, bool need_forging) const
 {
     condition condition;
 
@@ -128,10 +186,10 @@ condition_group condition_group::condition::operator&&(const condition& rhd) con
 
     std::get<0>(group._node) = logical_operator::and_;
 
-    group._left = std::make_shared<condition_group>();
+    group._left = make_node();
     std::get<1>(group._left->_node) = *this;
 
-    group._right = std::make_shared<condition_group>();
+    group._right = make_node();
     std::get<1>(group._right->_node) = rhd;
 
     return group;
@@ -143,10 +201,10 @@ condition_group condition_group::condition::operator&&(const condition_group& rh
 
     std::get<0>(group._node) = logical_operator::and_;
 
-    group._left = std::make_shared<condition_group>();
+    group._left = make_node();
     std::get<1>(group._left->_node) = *this;
 
-    group._right = std::make_shared<condition_group>(rhd);
+    group._right = make_node(rhd);
 
     return group;
 }
@@ -157,10 +215,10 @@ condition_group condition_group::condition::operator||(const condition& rhd) con
 
     std::get<0>(group._node) = logical_operator::or_;
 
-    group._left = std::make_shared<condition_group>();
+    group._left = make_node();
     std::get<1>(group._left->_node) = *this;
 
-    group._right = std::make_shared<condition_group>();
+    group._right = make_node();
     std::get<1>(group._right->_node) = rhd;
 
     return group;
@@ -172,77 +230,254 @@ condition_group condition_group::condition::operator||(const condition_group& rh
 
     std::get<0>(group._node) = logical_operator::or_;
 
-    group._left = std::make_shared<condition_group>();
+    group._left = make_node();
     std::get<1>(group._left->_node) = *this;
 
-    group._right = std::make_shared<condition_group>(rhd);
+    group._right = make_node(rhd);
 
     return group;
 }
 
 std::string condition_group::condition::unwrap(const condion_view_type view_type) const
+{
+    std::string out;
+    out.reserve(estimate_size(view_type));
+    unwrap(out, view_type);
+
+    return out;
+}
+
+void condition_group::condition::unwrap(std::string& out, const condion_view_type view_type) const
 {
     if(_values.empty())
-        return "";
+        return;
+
+    // Условия без столбца (EXISTS) начинаются сразу с оператора
+    if(_column.is_valid() || !_row_columns.empty()) {
+        unwrap_column(out, view_type);
+        out.append(" ");
+    }
+
+    out.append(_condition_operator->sql()).append(" ");
+
+    const auto need_bracket = _condition_operator->need_bracket();
 
-    std::stringstream stream;
+    if(need_bracket)
+        out.append("(");
+
+    for(auto it = _values.begin(); it != _values.end(); ++it) {
+        if(it != _values.begin())
+            out.append(", ");
+
+        const auto quoted = _need_forging && *it != column::null_value();
+
+        if(quoted)
+            out.append("'");
+
+        out.append(*it);
+
+        if(quoted)
+            out.append("'");
+    }
+
+    if(need_bracket)
+        out.append(")");
+}
+
+void condition_group::condition::unwrap_column(std::string& out, const condion_view_type view_type) const
+{
+    if(_row_columns.empty()) {
+        append_column(out, _column, view_type);
+        return;
+    }
 
+    out.append("(");
+
+    for(auto it = _row_columns.begin(); it != _row_columns.end(); ++it) {
+        if(it != _row_columns.begin())
+            out.append(", ");
+
+        append_column(out, *it, view_type);
+    }
+
+    out.append(")");
+}
+
+size_t condition_group::condition::column_size(const condion_view_type view_type) const
+{
+    if(_row_columns.empty())
+        return column_name_size(_column, view_type);
+
+    size_t size = 2 + (_row_columns.size() - 1) * 2;
+
+    for(const auto& row_column : _row_columns)
+        size += column_name_size(row_column, view_type);
+
+    return size;
+}
+
+void condition_group::condition::append_column(std::string& out, const column& column, const condion_view_type view_type)
+{
     switch(view_type) {
         case condion_view_type::name: {
-            stream << "\"" << _column.name() << "\"";
+            out.append("\"").append(column.name()).append("\"");
             break;
         }
         case condion_view_type::alias: {
-            stream << _column.alias();
+            out.append(column.alias());
             break;
         }
         case condion_view_type::full_name: {
-            stream << _column.full_name();
+            out.append(column.full_name());
             break;
         }
     }
+}
 
-    stream << " " << _condition_operator->sql() << " ";
+size_t condition_group::condition::column_name_size(const column& column, const condion_view_type view_type)
+{
+    switch(view_type) {
+        case condion_view_type::name:
+            return column.name().size() + 2;
+        case condion_view_type::alias:
+            return column.alias().size();
+        case condion_view_type::full_name:
+            return column.full_name().size();
+    }
 
-    if(_condition_operator->need_bracket())
-        stream << "(";
+    return 0;
+}
+
+size_t condition_group::condition::estimate_size(const condion_view_type view_type) const
+{
+    if(_values.empty())
+        return 0;
 
-    std::for_each(_values.begin(), _values.end(), [&stream, this](const auto& value) {
-        if(value != column::null_value() && _need_forging)
-            stream << "'";
+    size_t size = _condition_operator->sql().size() + 1;
 
-        stream << value;
+    if(_column.is_valid() || !_row_columns.empty())
+        size += column_size(view_type) + 1;
 
-        if(value != column::null_value() && _need_forging)
-            stream << "'";
+    if(_condition_operator->need_bracket())
+        size += 2;
 
-        if(_condition_operator->need_bracket())
-            stream << ", ";
-    });
+    for(const auto& value : _values) {
+        size += value.size();
 
-    if(_condition_operator->need_bracket()) {
-        stream.seekp(-2, std::stringstream::cur);
-        stream << ")";
+        if(_need_forging && value != column::null_value())
+            size += 2;
     }
 
-    return stream.str();
+    size += (_values.size() - 1) * 2;
+
+    return size;
+}
+
+condition_group::condition condition_group::condition::exists(const sub_query& query)
+{
+    if(!query.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой вложенный запрос");
+
+    condition condition;
+
+    condition._condition_operator = operators::shared_instance<operators::exists_operator>();
+    condition._values = { query.sql() };
+    condition._need_forging = false;
+
+    return condition;
+}
+
+condition_group::condition condition_group::condition::not_exists(const sub_query& query)
+{
+    if(!query.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой вложенный запрос");
+
+    condition condition;
+
+    condition._condition_operator = operators::shared_instance<operators::not_exists_operator>();
+    condition._values = { query.sql() };
+    condition._need_forging = false;
+
+    return condition;
+}
+
+condition_group::condition condition_group::condition::create(std::shared_ptr<operators::IOperator> condition_operator,
+    column condition_column,
+    value_list values,
+    const bool need_forging)
+{
+    if(condition_operator == nullptr)
+        throw std::invalid_argument("Ошибка. Отсутствует оператор условия");
+
+    condition condition;
+
+    condition._condition_operator = std::move(condition_operator);
+    condition._column = std::move(condition_column);
+    condition._values = std::move(values);
+    condition._need_forging = need_forging;
+
+    return condition;
 }
 
-condition_group::condition::column condition_group::condition::condition_column() const
+condition_group::condition condition_group::condition::row_in(std::vector<column> columns, value_list tuples)
+{
+    if(columns.empty())
+        throw std::invalid_argument("Ошибка. Отсутствуют столбцы составного ключа");
+
+    if(tuples.empty())
+        throw std::invalid_argument("Ошибка. Пустой список кортежей");
+
+    condition condition;
+
+    condition._condition_operator = operators::shared_instance<operators::in_operator>();
+    condition._row_columns = std::move(columns);
+    condition._values = std::move(tuples);
+    condition._need_forging = false;
+
+    return condition;
+}
+
+const condition_group::condition::column& condition_group::condition::condition_column() const
 {
     return _column;
 }
 
-std::shared_ptr<operators::IOperator> condition_group::condition::condition_operator() const
+const std::shared_ptr<operators::IOperator>& condition_group::condition::condition_operator() const
 {
     return _condition_operator;
 }
 
-std::vector<std::string> condition_group::condition::values() const
+const condition_group::condition::value_list& condition_group::condition::values() const
 {
     return _values;
 }
 
+bool condition_group::condition::need_forging() const
+{
+    return _need_forging;
+}
+
+const std::vector<condition_group::condition::column>& condition_group::condition::row_columns() const
+{
+    return _row_columns;
+}
+
+condition_group::condition condition_group::condition::with_column(const column& column) const
+{
+    auto result = *this;
+    result._column = column;
+
+    return result;
+}
+
+condition_group::condition condition_group::condition::with_values(value_list values) const
+{
+    auto result = *this;
+    result._values = std::move(values);
+
+    return result;
+}
+
 bool condition_group::condition::is_valid() const
 {
     return _condition_operator != nullptr || !_values.empty() || _column.is_valid();
@@ -259,9 +494,9 @@ condition_group condition_group::operator&&(const condition_group& rhd) const
 
     std::get<0>(group._node) = logical_operator::and_;
 
-    group._left = std::make_shared<condition_group>(*this);
+    group._left = make_node(*this);
 
-    group._right = std::make_shared<condition_group>(rhd);
+    group._right = make_node(rhd);
 
     return group;
 }
@@ -272,9 +507,9 @@ condition_group condition_group::operator&&(const condition& rhd) const
 
     std::get<0>(group._node) = logical_operator::and_;
 
-    group._left = std::make_shared<condition_group>(*this);
+    group._left = make_node(*this);
 
-    group._right = std::make_shared<condition_group>();
+    group._right = make_node();
     std::get<1>(group._right->_node) = rhd;
 
     return group;
@@ -286,9 +521,9 @@ condition_group condition_group::operator||(const condition_group& rhd) const
 
     std::get<0>(group._node) = logical_operator::or_;
 
-    group._left = std::make_shared<condition_group>(*this);
+    group._left = make_node(*this);
 
-    group._right = std::make_shared<condition_group>(rhd);
+    group._right = make_node(rhd);
 
     return group;
 }
@@ -299,9 +534,9 @@ condition_group condition_group::operator||(const condition& rhd) const
 
     std::get<0>(group._node) = logical_operator::or_;
 
-    group._left = std::make_shared<condition_group>(*this);
+    group._left = make_node(*this);
 
-    group._right = std::make_shared<condition_group>();
+    group._right = make_node();
     std::get<1>(group._right->_node) = rhd;
 
     return group;
@@ -309,10 +544,21 @@ condition_group condition_group::operator||(const condition& rhd) const
 
 std::string condition_group::unwrap(const condion_view_type view_type, const bool compressed) const
 {
-    std::stringstream stream;
-    unwrap_tree(this, stream, view_type, compressed);
+    std::string out;
+    out.reserve(estimate_size(view_type, compressed));
+    unwrap_tree(this, out, view_type, compressed);
+
+    return out;
+}
+
+void condition_group::unwrap(std::string& out, const condion_view_type view_type, const bool compressed) const
+{
+    unwrap_tree(this, out, view_type, compressed);
+}
 
-    return stream.str();
+size_t condition_group::estimate_size(const condion_view_type view_type, const bool compressed) const
+{
+    return tree_size(this, view_type, compressed);
 }
 
 bool condition_group::is_valid() const
@@ -320,41 +566,155 @@ bool condition_group::is_valid() const
     return !is_sheet() || std::get<1>(_node).is_valid();
 }
 
+bool condition_group::is_leaf() const
+{
+    return is_sheet();
+}
+
+const condition_group::condition& condition_group::leaf() const
+{
+    return std::get<1>(_node);
+}
+
+logical_operator condition_group::group_operator() const
+{
+    return std::get<0>(_node);
+}
+
+const condition_group* condition_group::left() const
+{
+    return _left.get();
+}
+
+const condition_group* condition_group::right() const
+{
+    return _right.get();
+}
+
+condition_group condition_group::transform(const std::function<condition_group(const condition&)>& leaf_transform) const
+{
+    if(is_sheet())
+        return leaf_transform(std::get<1>(_node));
+
+    condition_group group;
+
+    std::get<0>(group._node) = std::get<0>(_node);
+
+    if(_left != nullptr)
+        group._left = make_node(_left->transform(leaf_transform));
+
+    if(_right != nullptr)
+        group._right = make_node(_right->transform(leaf_transform));
+
+    return group;
+}
+
 bool condition_group::is_sheet() const
 {
     return _left == _right && _left == nullptr;
 }
 
-void condition_group::unwrap_tree(const condition_group* node, std::stringstream& stream, const condion_view_type view_type, const bool compressed)
+struct condition_group::fragment_cache
+{
+    /**
+     * Возвращает строковое представление узла, создавая его при первом обращении.
+     * @param node Узел, которому принадлежит кэш.
+     * @param view_type Настройки для отображения названия колонки.
+     * @return Строковое представление узла.
+     */
+    const std::string& fragment(const condition_group* node, const condion_view_type view_type)
+    {
+        const auto index = static_cast<size_t>(view_type);
+
+        std::call_once(once[index], [this, node, view_type, index]() {
+            render_node(node, fragments[index], view_type, true);
+        });
+
+        return fragments[index];
+    }
+
+    std::once_flag once[3];
+    std::string fragments[3];
+};
+
+std::shared_ptr<condition_group::fragment_cache> condition_group::make_fragment_cache()
+{
+    return std::make_shared<fragment_cache>();
+}
+
+void condition_group::unwrap_tree(const condition_group* node, std::string& out, const condion_view_type view_type, const bool compressed)
+{
+    if(compressed && node->_fragments != nullptr) {
+        out.append(node->_fragments->fragment(node, view_type));
+        return;
+    }
+
+    render_node(node, out, view_type, compressed);
+}
+
+void condition_group::render_node(const condition_group* node, std::string& out, const condion_view_type view_type, const bool compressed)
 {
     if(node->is_sheet()) {
-        stream << std::get<1>(node->_node).unwrap(view_type);
+        std::get<1>(node->_node).unwrap(out, view_type);
         return;
     }
 
-    stream << "(";
+    out.append("(");
 
     if(node->_left != nullptr)
-        unwrap_tree(node->_left.get(), stream, view_type, compressed);
+        unwrap_tree(node->_left.get(), out, view_type, compressed);
 
     if(!compressed)
-        stream << "\n";
+        out.append("\n");
 
     switch(std::get<0>(node->_node)) {
         case logical_operator::and_: {
-            stream << " AND ";
+            out.append(" AND ");
             break;
         }
         case logical_operator::or_: {
-            stream << " OR ";
+            out.append(" OR ");
             break;
         }
     }
 
     if(node->_right != nullptr)
-        unwrap_tree(node->_right.get(), stream, view_type, compressed);
+        unwrap_tree(node->_right.get(), out, view_type, compressed);
 
-    stream << ")";
+    out.append(")");
+}
+
+size_t condition_group::tree_size(const condition_group* node, const condion_view_type view_type, const bool compressed)
+{
+    if(compressed && node->_fragments != nullptr)
+        return node->_fragments->fragment(node, view_type).size();
+
+    if(node->is_sheet())
+        return std::get<1>(node->_node).estimate_size(view_type);
+
+    size_t size = 2;
+
+    if(node->_left != nullptr)
+        size += tree_size(node->_left.get(), view_type, compressed);
+
+    if(!compressed)
+        size += 1;
+
+    switch(std::get<0>(node->_node)) {
+        case logical_operator::and_: {
+            size += 5;
+            break;
+        }
+        case logical_operator::or_: {
+            size += 4;
+            break;
+        }
+    }
+
+    if(node->_right != nullptr)
+        size += tree_size(node->_right.get(), view_type, compressed);
+
+    return size;
 }
 
 column_settings operator|(column_settings a, column_settings b)
@@ -362,6 +722,16 @@ column_settings operator|(column_settings a, column_settings b)
     return static_cast<column_settings>(static_cast<uint8_t>(a) | static_cast<uint8_t>(b));
 }
 
+condition_info exists(const sub_query& query)
+{
+    return condition_info::exists(query);
+}
+
+condition_info not_exists(const sub_query& query)
+{
+    return condition_info::not_exists(query);
+}
+
 column_settings primary_key()
 {
     return column_settings::primary_key | column_settings::not_null;
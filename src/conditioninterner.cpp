@@ -0,0 +1,184 @@
+#include "QueryCraft/conditioninterner.h"
+
+#include <stdexcept>
+
+namespace {
+
+using namespace query_craft;
+
+/// Вид ключа общего узла.
+enum class key_tag : char
+{
+    empty = 'e',
+    leaf = 'l',
+    and_ = 'a',
+    or_ = 'o'
+};
+
+void append_size(std::string& key, size_t value)
+{
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void append_string(std::string& key, const std::string& value)
+{
+    append_size(key, value.size());
+    key.append(value);
+}
+
+void append_pointer(std::string& key, const void* pointer)
+{
+    key.append(reinterpret_cast<const char*>(&pointer), sizeof(pointer));
+}
+
+void append_column(std::string& key, const column_info& column)
+{
+    append_string(key, column.name());
+    append_string(key, column.full_name());
+    append_string(key, column.alias());
+
+    uint8_t settings = 0;
+    for(const auto flag : { column_settings::primary_key, column_settings::not_null, column_settings::auto_increment }) {
+        if(column.has_settings(flag))
+            settings |= static_cast<uint8_t>(flag);
+    }
+
+    key.push_back(static_cast<char>(settings));
+}
+
+} // namespace
+
+namespace query_craft {
+
+condition_interner::interned condition_interner::intern(const condition_group& condition)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Общие узлы живут дольше арены запроса, поэтому их значения выделяются в глобальной куче
+    const memory::scoped_resource heap(memory::new_delete_resource());
+
+    return intern_node(condition);
+}
+
+condition_interner::interned condition_interner::and_(const interned& lhs, const interned& rhs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const memory::scoped_resource heap(memory::new_delete_resource());
+
+    return intern_group(logical_operator::and_, own(lhs), own(rhs));
+}
+
+condition_interner::interned condition_interner::or_(const interned& lhs, const interned& rhs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    const memory::scoped_resource heap(memory::new_delete_resource());
+
+    return intern_group(logical_operator::or_, own(lhs), own(rhs));
+}
+
+size_t condition_interner::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    return _nodes.size();
+}
+
+void condition_interner::clear()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    _nodes.clear();
+}
+
+std::shared_ptr<condition_group> condition_interner::intern_node(const condition_group& node)
+{
+    if(!node.is_valid())
+        return find_or_insert(std::string(1, static_cast<char>(key_tag::empty)), condition_group());
+
+    if(!node.is_leaf()) {
+        const auto left = node.left() != nullptr ? intern_node(*node.left()) : nullptr;
+        const auto right = node.right() != nullptr ? intern_node(*node.right()) : nullptr;
+
+        return intern_group(node.group_operator(), left, right);
+    }
+
+    std::string key(1, static_cast<char>(key_tag::leaf));
+    append_leaf_key(key, node.leaf());
+
+    return find_or_insert(std::move(key), condition_group(node.leaf()));
+}
+
+std::shared_ptr<condition_group> condition_interner::intern_group(const logical_operator group_operator,
+    const std::shared_ptr<condition_group>& left,
+    const std::shared_ptr<condition_group>& right)
+{
+    std::string key(1, static_cast<char>(group_operator == logical_operator::and_ ? key_tag::and_ : key_tag::or_));
+
+    // Дочерние узлы уже общие, поэтому их адреса однозначно определяют поддеревья
+    append_pointer(key, left.get());
+    append_pointer(key, right.get());
+
+    condition_group group;
+    std::get<0>(group._node) = group_operator;
+    group._left = left;
+    group._right = right;
+
+    return find_or_insert(std::move(key), std::move(group));
+}
+
+std::shared_ptr<condition_group> condition_interner::find_or_insert(std::string&& key, condition_group&& node)
+{
+    const auto found = _nodes.find(key);
+    if(found != _nodes.end())
+        return found->second;
+
+    node._fragments = condition_group::make_fragment_cache();
+
+    auto shared = std::make_shared<condition_group>(std::move(node));
+    _nodes.emplace(std::move(key), shared);
+
+    return shared;
+}
+
+std::shared_ptr<condition_group> condition_interner::own(const interned& node)
+{
+    if(node == nullptr)
+        throw std::invalid_argument("Ошибка. Пустой указатель на условие");
+
+    // Узлы с кэшем представлений создаются только интернером и никогда не изменяются
+    if(node->_fragments != nullptr)
+        return std::const_pointer_cast<condition_group>(node);
+
+    return intern_node(*node);
+}
+
+void condition_interner::append_leaf_key(std::string& key, const condition_group::condition& leaf)
+{
+    const auto& condition_operator = leaf.condition_operator();
+
+    if(condition_operator == nullptr) {
+        key.push_back(0);
+    } else {
+        key.push_back(static_cast<char>(static_cast<uint8_t>(condition_operator->type()) + 1));
+
+        // Пользовательские операторы различаются только экземпляром
+        if(condition_operator->type() == operator_type::custom)
+            append_pointer(key, condition_operator.get());
+    }
+
+    key.push_back(leaf.need_forging() ? 1 : 0);
+
+    append_column(key, leaf.condition_column());
+
+    const auto& row_columns = leaf.row_columns();
+    append_size(key, row_columns.size());
+    for(const auto& column : row_columns)
+        append_column(key, column);
+
+    const auto& values = leaf.values();
+    append_size(key, values.size());
+    for(const auto& value : values)
+        append_string(key, value);
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,778 @@
+#include "QueryCraft/helper/sqlrenderer.h"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+
+query_craft::array_view<query_craft::column_info> choose_columns(const query_craft::table& schema, query_craft::array_view<query_craft::column_info> columns)
+{
+    return columns.empty() ? schema.columns() : columns;
+}
+
+void append_quoted_name(std::string& out, const std::string& name)
+{
+    out.append("\"").append(name).append("\"");
+}
+
+size_t quoted_names_size(query_craft::array_view<query_craft::column_info> columns)
+{
+    size_t size = 0;
+    for(const auto& column : columns)
+        size += column.name().size() + 2;
+
+    return size + (columns.size() - 1) * 2;
+}
+
+void append_quoted_names(std::string& out, query_craft::array_view<query_craft::column_info> columns)
+{
+    for(auto it = columns.begin(); it != columns.end(); ++it) {
+        if(it != columns.begin())
+            out.append(", ");
+
+        append_quoted_name(out, it->name());
+    }
+}
+
+void validate_rows(query_craft::array_view<query_craft::column_info> columns, const std::vector<query_craft::helper::row>& rows)
+{
+    if(columns.empty())
+        throw std::invalid_argument("Ошибка. Отсутствует информация о колонках");
+
+    if(rows.empty())
+        throw std::invalid_argument("Ошибка. Отсутвуют строки для всатвки");
+
+    if(rows.front().size() != columns.size())
+        throw std::invalid_argument("Ошибка. Не совпадает колличество колонок с размером данных");
+}
+
+void validate_update_rows(query_craft::array_view<query_craft::column_info> columns, const std::vector<query_craft::helper::row>& rows)
+{
+    validate_rows(columns, rows);
+
+    if(rows.size() != 1)
+        throw std::invalid_argument("Ошибка. В рамках запроса update можно обновить использовать только 1 строку");
+}
+
+void validate_changed_row(query_craft::array_view<query_craft::column_info> columns, const query_craft::helper::row& new_row, const std::vector<bool>& changed)
+{
+    if(columns.empty())
+        throw std::invalid_argument("Ошибка. Отсутствует информация о колонках");
+
+    if(new_row.size() != columns.size() || changed.size() != columns.size())
+        throw std::invalid_argument("Ошибка. Не совпадает колличество колонок с размером данных");
+}
+
+void validate_column_counts(query_craft::array_view<query_craft::column_info> target_columns, query_craft::array_view<query_craft::column_info> source_columns)
+{
+    if(target_columns.empty() || source_columns.empty())
+        throw std::invalid_argument("Ошибка. Отсутствует информация о колонках");
+
+    if(target_columns.size() != source_columns.size())
+        throw std::invalid_argument("Ошибка. Не совпадает количество колонок вставки и выборки");
+}
+
+const query_craft::column_info& primary_key_column(const query_craft::table& schema)
+{
+    const query_craft::column_info* key = nullptr;
+
+    for(const auto& column : schema.columns()) {
+        if(!column.has_settings(query_craft::column_settings::primary_key))
+            continue;
+
+        if(key != nullptr)
+            throw std::invalid_argument("Ошибка. Ограничение количества строк требует единственного первичного ключа");
+
+        key = &column;
+    }
+
+    if(key == nullptr)
+        throw std::invalid_argument("Ошибка. Ограничение количества строк требует первичного ключа");
+
+    return *key;
+}
+
+/**
+ * Добавляет список присваиваний "column" = value для отмеченных столбцов.
+ */
+void append_assignments(std::string& out,
+    query_craft::array_view<query_craft::column_info> columns,
+    const query_craft::helper::row& new_row,
+    const std::vector<bool>& changed)
+{
+    auto first = true;
+
+    for(size_t i = 0; i < columns.size(); i++) {
+        if(!changed[i])
+            continue;
+
+        if(!first)
+            out.append(", ");
+
+        first = false;
+
+        append_quoted_name(out, columns[i].name());
+        out.append(" = ");
+        query_craft::helper::append_escaped_value(out, new_row[i]);
+    }
+}
+
+/**
+ * Добавляет проверку, что хотя бы один отмеченный столбец отличается от нового значения.
+ */
+void append_distinct_guard(std::string& out,
+    query_craft::array_view<query_craft::column_info> columns,
+    const query_craft::helper::row& new_row,
+    const std::vector<bool>& changed)
+{
+    const auto count = static_cast<size_t>(std::count(changed.begin(), changed.end(), true));
+
+    if(count > 1)
+        out.append("(");
+
+    auto first = true;
+
+    for(size_t i = 0; i < columns.size(); i++) {
+        if(!changed[i])
+            continue;
+
+        if(!first)
+            out.append(" OR ");
+
+        first = false;
+
+        append_quoted_name(out, columns[i].name());
+        out.append(" IS DISTINCT FROM ");
+        query_craft::helper::append_escaped_value(out, new_row[i]);
+    }
+
+    if(count > 1)
+        out.append(")");
+}
+
+/**
+ * Добавляет условие выбора строк по значениям ключа: "key" = value либо "key" IN (...).
+ * Значения ключа берутся из строк вызывающей стороны и экранируются так же, как присваиваемые значения.
+ */
+void append_key_condition(std::string& out, const query_craft::column_info& key, const std::vector<std::string>& keys)
+{
+    append_quoted_name(out, key.name());
+
+    if(keys.size() == 1) {
+        out.append(" = ");
+        query_craft::helper::append_escaped_value(out, keys.front());
+        return;
+    }
+
+    out.append(" IN (");
+
+    for(auto it = keys.begin(); it != keys.end(); ++it) {
+        if(it != keys.begin())
+            out.append(", ");
+
+        query_craft::helper::append_escaped_value(out, *it);
+    }
+
+    out.append(")");
+}
+
+} // namespace
+
+namespace query_craft {
+namespace helper {
+
+void append_escaped_value(std::string& out, const std::string& value)
+{
+    const auto is_null = value == column_info::null_value();
+
+    if(!is_null)
+        out.append("'");
+
+    for(size_t i = 0; i < value.size(); i++) {
+        const auto ch = value[i];
+
+        switch(ch) {
+            case '\'': {
+                out.append("''");
+                break;
+            }
+
+            case '\\': {
+                // Доп обработка для json формата
+                if(i + 1 < value.size() && value[i + 1] == '"') {
+                    out.push_back(ch);
+                } else {
+                    out.append("\\\\");
+                }
+
+                break;
+            }
+
+            default: {
+                out.push_back(ch);
+            }
+        }
+    }
+
+    if(!is_null)
+        out.append("'");
+}
+
+size_t escaped_value_size(const std::string& value)
+{
+    size_t size = value.size();
+
+    if(value != column_info::null_value())
+        size += 2;
+
+    for(size_t i = 0; i < value.size(); i++) {
+        if(value[i] == '\'' || (value[i] == '\\' && !(i + 1 < value.size() && value[i + 1] == '"')))
+            size++;
+    }
+
+    return size;
+}
+
+void append_number(std::string& out, size_t value)
+{
+    char buffer[20];
+    size_t length = 0;
+
+    do {
+        buffer[length++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while(value != 0);
+
+    while(length != 0)
+        out.push_back(buffer[--length]);
+}
+
+size_t number_size(size_t value)
+{
+    size_t size = 1;
+    while(value >= 10) {
+        value /= 10;
+        size++;
+    }
+
+    return size;
+}
+
+void append_select_list(std::string& out, array_view<column_info> columns)
+{
+    if(columns.empty()) {
+        out.append("*");
+        return;
+    }
+
+    for(auto it = columns.begin(); it != columns.end(); ++it) {
+        if(it != columns.begin())
+            out.append(", ");
+
+        out.append(it->full_name()).append(" AS ").append(it->alias());
+    }
+}
+
+size_t select_list_size(array_view<column_info> columns)
+{
+    if(columns.empty())
+        return 1;
+
+    size_t size = 0;
+    for(const auto& column : columns)
+        size += column.full_name().size() + 4 + column.alias().size();
+
+    return size + (columns.size() - 1) * 2;
+}
+
+void append_joins(std::string& out, array_view<join_column> join_columns)
+{
+    for(const auto& join : join_columns) {
+        switch(join.join_type) {
+            case join_column::type::inner: {
+                out.append(" INNER ");
+                break;
+            }
+            case join_column::type::outer: {
+                out.append(" OUTER ");
+                break;
+            }
+            case join_column::type::left: {
+                out.append(" LEFT ");
+                break;
+            }
+            case join_column::type::right: {
+                out.append(" RIGHT ");
+                break;
+            }
+            case join_column::type::cross: {
+                out.append(" CROSS ");
+                break;
+            }
+        }
+
+        out.append("JOIN ").append(join.joined_table.table_name()).append(" ON ");
+        join.condition.unwrap(out, condion_view_type::full_name);
+    }
+}
+
+size_t joins_size(array_view<join_column> join_columns)
+{
+    size_t size = 0;
+
+    for(const auto& join : join_columns) {
+        switch(join.join_type) {
+            case join_column::type::inner:
+            case join_column::type::outer:
+            case join_column::type::right:
+            case join_column::type::cross: {
+                size += 7;
+                break;
+            }
+            case join_column::type::left: {
+                size += 6;
+                break;
+            }
+        }
+
+        size += 5 + join.joined_table.table_name().size() + 4 + join.condition.estimate_size(condion_view_type::full_name);
+    }
+
+    return size;
+}
+
+void append_where(std::string& out, const condition_group& condition, const condion_view_type view_type)
+{
+    if(!condition.is_valid())
+        return;
+
+    out.append(" WHERE ");
+    condition.unwrap(out, view_type);
+}
+
+size_t where_size(const condition_group& condition, const condion_view_type view_type)
+{
+    if(!condition.is_valid())
+        return 0;
+
+    return 7 + condition.estimate_size(view_type);
+}
+
+void append_order_by(std::string& out, array_view<sort_column> sort_columns)
+{
+    if(sort_columns.empty())
+        return;
+
+    out.append(" ORDER BY ");
+
+    for(auto it = sort_columns.begin(); it != sort_columns.end(); ++it) {
+        if(it != sort_columns.begin())
+            out.append(", ");
+
+        out.append(it->column.alias());
+
+        switch(it->sort_type) {
+            case sort_column::type::asc:
+                out.append(" ASC");
+                break;
+            case sort_column::type::desc:
+                out.append(" DESC");
+                break;
+        }
+    }
+}
+
+size_t order_by_size(array_view<sort_column> sort_columns)
+{
+    if(sort_columns.empty())
+        return 0;
+
+    size_t size = 10;
+
+    for(const auto& sort : sort_columns) {
+        size += sort.column.alias().size();
+        size += sort.sort_type == sort_column::type::asc ? 4 : 5;
+    }
+
+    return size + (sort_columns.size() - 1) * 2;
+}
+
+void append_limit_offset(std::string& out, const size_t limit, const size_t offset)
+{
+    if(limit != 0) {
+        out.append(" LIMIT ");
+        append_number(out, limit);
+    }
+
+    if(offset != 0) {
+        out.append(" OFFSET ");
+        append_number(out, offset);
+    }
+}
+
+size_t limit_offset_size(const size_t limit, const size_t offset)
+{
+    size_t size = 0;
+
+    if(limit != 0)
+        size += 7 + number_size(limit);
+
+    if(offset != 0)
+        size += 8 + number_size(offset);
+
+    return size;
+}
+
+void insert_sql(std::string& out,
+    const table& schema,
+    const std::vector<row>& rows,
+    array_view<column_info> columns,
+    const bool need_returning,
+    array_view<column_info> returning_columns)
+{
+    const auto& insert_columns = choose_columns(schema, columns);
+
+    validate_rows(insert_columns, rows);
+
+    out.append("INSERT INTO ").append(schema.table_name()).append(" (");
+    append_quoted_names(out, insert_columns);
+    out.append(") VALUES");
+
+    for(auto row_it = rows.begin(); row_it != rows.end(); ++row_it) {
+        if(row_it != rows.begin())
+            out.append(",");
+
+        out.append(" (");
+
+        for(auto value_it = row_it->begin(); value_it != row_it->end(); ++value_it) {
+            if(value_it != row_it->begin())
+                out.append(", ");
+
+            append_escaped_value(out, *value_it);
+        }
+
+        out.append(")");
+    }
+
+    if(need_returning) {
+        out.append(" RETURNING ");
+
+        if(returning_columns.empty()) {
+            out.append("*");
+        } else {
+            append_quoted_names(out, returning_columns);
+        }
+    }
+
+    out.append(";");
+}
+
+std::string insert_sql(const table& schema,
+    const std::vector<row>& rows,
+    array_view<column_info> columns,
+    const bool need_returning,
+    array_view<column_info> returning_columns)
+{
+    std::string sql;
+    sql.reserve(insert_sql_size(schema, rows, columns, need_returning, returning_columns));
+    insert_sql(sql, schema, rows, columns, need_returning, returning_columns);
+
+    return sql;
+}
+
+size_t insert_sql_size(const table& schema,
+    const std::vector<row>& rows,
+    array_view<column_info> columns,
+    const bool need_returning,
+    array_view<column_info> returning_columns)
+{
+    const auto& insert_columns = choose_columns(schema, columns);
+
+    validate_rows(insert_columns, rows);
+
+    // "INSERT INTO " + table + " (" + columns + ") VALUES"
+    size_t size = 12 + schema.table_name().size() + 2 + quoted_names_size(insert_columns) + 8;
+
+    for(const auto& row : rows) {
+        // " (" + values + ")"
+        size += 3 + (row.size() - 1) * 2;
+
+        for(const auto& value : row)
+            size += escaped_value_size(value);
+    }
+
+    // Запятые между строками
+    size += rows.size() - 1;
+
+    if(need_returning)
+        size += 11 + (returning_columns.empty() ? 1 : quoted_names_size(returning_columns));
+
+    return size + 1;
+}
+
+void update_sql(std::string& out,
+    const table& schema,
+    const std::vector<row>& rows,
+    const condition_group& condition,
+    array_view<column_info> columns)
+{
+    const auto& update_columns = choose_columns(schema, columns);
+
+    validate_update_rows(update_columns, rows);
+
+    out.append("UPDATE ").append(schema.table_name()).append(" SET ");
+
+    const auto& row = rows.front();
+    for(size_t i = 0; i < update_columns.size(); i++) {
+        if(i != 0)
+            out.append(", ");
+
+        append_quoted_name(out, update_columns[i].name());
+        out.append(" = ");
+        append_escaped_value(out, row[i]);
+    }
+
+    append_where(out, condition, condion_view_type::name);
+
+    out.append(";");
+}
+
+std::string update_sql(const table& schema,
+    const std::vector<row>& rows,
+    const condition_group& condition,
+    array_view<column_info> columns)
+{
+    std::string sql;
+    sql.reserve(update_sql_size(schema, rows, condition, columns));
+    update_sql(sql, schema, rows, condition, columns);
+
+    return sql;
+}
+
+size_t update_sql_size(const table& schema,
+    const std::vector<row>& rows,
+    const condition_group& condition,
+    array_view<column_info> columns)
+{
+    const auto& update_columns = choose_columns(schema, columns);
+
+    validate_update_rows(update_columns, rows);
+
+    // "UPDATE " + table + " SET "
+    size_t size = 7 + schema.table_name().size() + 5;
+
+    const auto& row = rows.front();
+    for(size_t i = 0; i < update_columns.size(); i++)
+        size += update_columns[i].name().size() + 2 + 3 + escaped_value_size(row[i]);
+
+    size += (update_columns.size() - 1) * 2;
+
+    return size + where_size(condition, condion_view_type::name) + 1;
+}
+
+std::vector<bool> changed_columns(const row& old_row, const row& new_row)
+{
+    if(old_row.size() != new_row.size())
+        throw std::invalid_argument("Ошибка. Не совпадает размер старой и новой строки");
+
+    std::vector<bool> changed(old_row.size());
+    for(size_t i = 0; i < old_row.size(); i++)
+        changed[i] = old_row[i] != new_row[i];
+
+    return changed;
+}
+
+bool masked_update_sql(std::string& out,
+    const table& schema,
+    const row& new_row,
+    const std::vector<bool>& changed,
+    const condition_group& condition,
+    const bool distinct_guard,
+    array_view<column_info> columns)
+{
+    const auto update_columns = choose_columns(schema, columns);
+
+    validate_changed_row(update_columns, new_row, changed);
+
+    if(std::find(changed.begin(), changed.end(), true) == changed.end())
+        return false;
+
+    out.append("UPDATE ").append(schema.table_name()).append(" SET ");
+    append_assignments(out, update_columns, new_row, changed);
+
+    if(condition.is_valid()) {
+        out.append(" WHERE ");
+        condition.unwrap(out, condion_view_type::name);
+
+        if(distinct_guard)
+            out.append(" AND ");
+    } else if(distinct_guard) {
+        out.append(" WHERE ");
+    }
+
+    if(distinct_guard)
+        append_distinct_guard(out, update_columns, new_row, changed);
+
+    out.append(";");
+
+    return true;
+}
+
+std::vector<std::string> diff_update_sql(const table& schema,
+    const std::vector<std::pair<row, row>>& changes,
+    const column_info& key,
+    const bool distinct_guard,
+    array_view<column_info> columns)
+{
+    const auto update_columns = choose_columns(schema, columns);
+
+    const auto key_it = std::find_if(update_columns.begin(), update_columns.end(), [&key](const column_info& column) {
+        return column.name() == key.name();
+    });
+
+    if(key_it == update_columns.end())
+        throw std::invalid_argument("Ошибка. Ключевой столбец отсутствует в списке колонок");
+
+    const auto key_index = static_cast<size_t>(key_it - update_columns.begin());
+
+    // Строки с одинаковыми присваиваниями объединяются в один запрос
+    struct group
+    {
+        std::string assignments;
+        std::string guard;
+        std::vector<std::string> keys;
+    };
+
+    std::vector<group> groups;
+    std::unordered_map<std::string, size_t> group_index;
+    std::string assignments;
+
+    for(const auto& change : changes) {
+        const auto changed = changed_columns(change.first, change.second);
+
+        validate_changed_row(update_columns, change.second, changed);
+
+        if(std::find(changed.begin(), changed.end(), true) == changed.end())
+            continue;
+
+        const auto& key_value = change.first[key_index];
+        if(key_value == column_info::null_value())
+            throw std::invalid_argument("Ошибка. Значение ключа не может быть NULL");
+
+        assignments.clear();
+        append_assignments(assignments, update_columns, change.second, changed);
+
+        const auto found = group_index.find(assignments);
+        if(found != group_index.end()) {
+            groups[found->second].keys.push_back(key_value);
+            continue;
+        }
+
+        group current;
+        current.assignments = assignments;
+        current.keys.push_back(key_value);
+
+        if(distinct_guard)
+            append_distinct_guard(current.guard, update_columns, change.second, changed);
+
+        group_index.emplace(assignments, groups.size());
+        groups.push_back(std::move(current));
+    }
+
+    std::vector<std::string> statements;
+    statements.reserve(groups.size());
+
+    for(const auto& current : groups) {
+        std::string sql;
+        sql.append("UPDATE ").append(schema.table_name()).append(" SET ").append(current.assignments);
+
+        sql.append(" WHERE ");
+        append_key_condition(sql, key, current.keys);
+
+        if(distinct_guard)
+            sql.append(" AND ").append(current.guard);
+
+        sql.append(";");
+
+        statements.push_back(std::move(sql));
+    }
+
+    return statements;
+}
+
+void insert_from_select_sql(std::string& out,
+    const table& target,
+    array_view<column_info> target_columns,
+    const table& source,
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    const size_t limit,
+    const size_t offset,
+    array_view<column_info> source_columns)
+{
+    const auto insert_columns = choose_columns(target, target_columns);
+    const auto select_columns = choose_columns(source, source_columns);
+
+    validate_column_counts(insert_columns, select_columns);
+
+    out.append("INSERT INTO ").append(target.table_name()).append(" (");
+    append_quoted_names(out, insert_columns);
+    out.append(") SELECT ");
+
+    append_select_list(out, select_columns);
+
+    out.append(" FROM ").append(source.table_name());
+
+    append_joins(out, join_columns);
+    append_where(out, condition, condion_view_type::full_name);
+    append_order_by(out, sort_columns);
+    append_limit_offset(out, limit, offset);
+
+    out.append(";");
+}
+
+void move_rows_sql(std::string& out,
+    const table& source,
+    const table& target,
+    const condition_group& condition,
+    array_view<column_info> source_columns,
+    array_view<column_info> target_columns,
+    const size_t batch_limit)
+{
+    const auto moved_columns = choose_columns(source, source_columns);
+    const auto insert_columns = choose_columns(target, target_columns);
+
+    validate_column_counts(insert_columns, moved_columns);
+
+    out.append("WITH moved AS (DELETE FROM ").append(source.table_name());
+
+    if(batch_limit != 0) {
+        const auto& key = primary_key_column(source);
+
+        out.append(" WHERE ");
+        append_quoted_name(out, key.name());
+        out.append(" IN (SELECT ");
+        append_quoted_name(out, key.name());
+        out.append(" FROM ").append(source.table_name());
+
+        append_where(out, condition, condion_view_type::name);
+        append_limit_offset(out, batch_limit, 0);
+
+        out.append(")");
+    } else {
+        append_where(out, condition, condion_view_type::name);
+    }
+
+    out.append(" RETURNING ");
+    append_quoted_names(out, moved_columns);
+
+    out.append(") INSERT INTO ").append(target.table_name()).append(" (");
+    append_quoted_names(out, insert_columns);
+    out.append(") SELECT ");
+    append_quoted_names(out, moved_columns);
+    out.append(" FROM moved;");
+}
+
+} // namespace helper
+} // namespace query_craft
\ No newline at end of file
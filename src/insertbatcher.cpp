@@ -0,0 +1,280 @@
+#include "QueryCraft/insertbatcher.h"
+
+#include "QueryCraft/helper/sqlrenderer.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace query_craft {
+
+insert_batcher::insert_batcher(shared_schema schema, sink sink, settings settings)
+    : _schema(std::move(schema))
+    , _sink(std::move(sink))
+    , _settings(std::move(settings))
+{
+    if(_schema == nullptr)
+        throw std::invalid_argument("Ошибка. Отсутствует описание таблицы");
+
+    if(!_sink)
+        throw std::invalid_argument("Ошибка. Отсутствует приемник запросов");
+
+    if(_settings.max_rows == 0 || _settings.max_bytes == 0)
+        throw std::invalid_argument("Ошибка. Пороги сброса должны быть больше нуля");
+
+    if(_settings.shard_count == 0)
+        _settings.shard_count = std::max(1u, std::thread::hardware_concurrency());
+
+    _shards.reset(new shard[_settings.shard_count]);
+
+    _worker = std::thread(&insert_batcher::run, this);
+}
+
+insert_batcher::insert_batcher(shared_schema schema, sink sink)
+    : insert_batcher(std::move(schema), std::move(sink), settings())
+{
+}
+
+insert_batcher::~insert_batcher()
+{
+    try {
+        stop();
+    } catch(...) {
+        // Ошибки приемника при остановке в деструкторе пробросить некуда
+    }
+}
+
+void insert_batcher::add_row(row row)
+{
+    rethrow_sink_error();
+
+    if(row.empty())
+        throw std::logic_error("Ошибка. Попытка добавить пустую строку");
+
+    const auto column_count = _settings.columns.empty() ? _schema->columns().size() : _settings.columns.size();
+    if(row.size() != column_count)
+        throw std::logic_error("Ошибка. Не совпадает размер строки с количеством колонок");
+
+    const auto bytes = row_bytes(row);
+
+    // Счетчики увеличиваются до публикации строки, чтобы сброс не мог вычесть ее раньше, чем она была учтена
+    size_t rows_before = 0;
+    reserve_row(rows_before);
+
+    const auto bytes_before = _pending_bytes.fetch_add(bytes);
+
+    {
+        auto& target = current_shard();
+        std::lock_guard<std::mutex> lock(target.mutex);
+        target.rows.push_back(std::move(row));
+    }
+
+    _active_producers.fetch_sub(1);
+
+    const auto rows_crossed = rows_before < _settings.max_rows && rows_before + 1 >= _settings.max_rows;
+    const auto bytes_crossed = bytes_before < _settings.max_bytes && bytes_before + bytes >= _settings.max_bytes;
+
+    if(rows_crossed || bytes_crossed) {
+        std::lock_guard<std::mutex> lock(_state_mutex);
+        _flush_requested = true;
+        _flush_cv.notify_one();
+    }
+}
+
+void insert_batcher::reserve_row(size_t& rows_before)
+{
+    while(true) {
+        if(_pending_rows.load() >= _settings.max_pending_rows) {
+            std::unique_lock<std::mutex> lock(_state_mutex);
+
+            _flush_requested = true;
+            _flush_cv.notify_one();
+
+            _space_cv.wait(lock, [this]() {
+                return _stopping || _pending_rows.load() < _settings.max_pending_rows;
+            });
+        }
+
+        _active_producers.fetch_add(1);
+
+        if(_stopping.load()) {
+            _active_producers.fetch_sub(1);
+            throw std::logic_error("Ошибка. Попытка добавить строку после остановки");
+        }
+
+        // Проверка и увеличение выполняются одной операцией, иначе одновременные производители
+        // могут пройти проверку вместе и превысить ограничение
+        rows_before = _pending_rows.load();
+        while(rows_before < _settings.max_pending_rows) {
+            if(_pending_rows.compare_exchange_weak(rows_before, rows_before + 1))
+                return;
+        }
+
+        // Место заняли другие производители, ожидание повторяется
+        _active_producers.fetch_sub(1);
+    }
+}
+
+void insert_batcher::flush()
+{
+    drain();
+    rethrow_sink_error();
+}
+
+void insert_batcher::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(_state_mutex);
+        _stopping = true;
+    }
+
+    _flush_cv.notify_one();
+    _space_cv.notify_all();
+
+    while(_active_producers.load() != 0)
+        std::this_thread::yield();
+
+    if(_worker.joinable())
+        _worker.join();
+
+    // Строки, добавленные после последнего сброса фонового потока
+    drain();
+
+    rethrow_sink_error();
+}
+
+size_t insert_batcher::pending_rows() const
+{
+    return _pending_rows.load();
+}
+
+void insert_batcher::run()
+{
+    // После ошибки приемника повторная отправка выполняется не чаще раза в max_delay,
+    // иначе неотправленные строки выше порога запускали бы сброс непрерывно
+    bool failed = false;
+
+    while(true) {
+        bool stopping = false;
+
+        {
+            std::unique_lock<std::mutex> lock(_state_mutex);
+
+            _flush_cv.wait_for(lock, _settings.max_delay, [this, failed]() {
+                return _stopping
+                    || (!failed
+                        && (_flush_requested
+                            || _pending_rows.load() >= _settings.max_rows
+                            || _pending_bytes.load() >= _settings.max_bytes));
+            });
+
+            _flush_requested = false;
+            stopping = _stopping;
+        }
+
+        failed = !drain();
+
+        if(stopping)
+            break;
+    }
+}
+
+bool insert_batcher::drain()
+{
+    std::lock_guard<std::mutex> sink_lock(_sink_mutex);
+
+    // Строки, не принятые приемником ранее, отправляются первыми
+    std::vector<row> rows;
+    rows.swap(_failed_rows);
+
+    for(size_t i = 0; i < _settings.shard_count; i++) {
+        auto& current = _shards[i];
+        std::lock_guard<std::mutex> lock(current.mutex);
+
+        if(rows.empty()) {
+            rows.swap(current.rows);
+        } else {
+            rows.insert(rows.end(), std::make_move_iterator(current.rows.begin()), std::make_move_iterator(current.rows.end()));
+            current.rows.clear();
+        }
+    }
+
+    auto begin = rows.begin();
+    while(begin != rows.end()) {
+        auto end = begin;
+        size_t chunk_bytes = 0;
+
+        while(end != rows.end()
+            && static_cast<size_t>(end - begin) < _settings.max_rows
+            && (end == begin || chunk_bytes < _settings.max_bytes)) {
+            chunk_bytes += row_bytes(*end);
+            ++end;
+        }
+
+        std::vector<row> chunk(std::make_move_iterator(begin), std::make_move_iterator(end));
+
+        try {
+            _sink(helper::insert_sql(*_schema, chunk, _settings.columns, false, {}), chunk);
+        } catch(...) {
+            {
+                std::lock_guard<std::mutex> lock(_error_mutex);
+                if(_sink_error == nullptr)
+                    _sink_error = std::current_exception();
+
+                _has_sink_error.store(true);
+            }
+
+            // Пачка и оставшиеся строки возвращаются в очередь и остаются учтенными в счетчиках
+            _failed_rows = std::move(chunk);
+            _failed_rows.insert(_failed_rows.end(), std::make_move_iterator(end), std::make_move_iterator(rows.end()));
+
+            return false;
+        }
+
+        _pending_rows.fetch_sub(chunk.size());
+        _pending_bytes.fetch_sub(chunk_bytes);
+
+        {
+            std::lock_guard<std::mutex> lock(_state_mutex);
+        }
+        _space_cv.notify_all();
+
+        begin = end;
+    }
+
+    return true;
+}
+
+void insert_batcher::rethrow_sink_error()
+{
+    if(!_has_sink_error.load())
+        return;
+
+    std::exception_ptr error;
+
+    {
+        std::lock_guard<std::mutex> lock(_error_mutex);
+        std::swap(error, _sink_error);
+        _has_sink_error.store(false);
+    }
+
+    if(error != nullptr)
+        std::rethrow_exception(error);
+}
+
+insert_batcher::shard& insert_batcher::current_shard()
+{
+    const auto index = std::hash<std::thread::id>()(std::this_thread::get_id()) % _settings.shard_count;
+    return _shards[index];
+}
+
+size_t insert_batcher::row_bytes(const row& row)
+{
+    // Значение, кавычки и разделитель
+    size_t bytes = 4;
+    for(const auto& value : row)
+        bytes += value.size() + 4;
+
+    return bytes;
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "QueryCraft/likerewrite.h"
+
+namespace {
+
+/**
+ * Декодирует символ UTF-8, начинающийся с позиции start и занимающий остаток строки.
+ * @return false, если последовательность байтов некорректна.
+ */
+bool decode_last_char(const std::string& value, const size_t start, uint32_t& code_point)
+{
+    const auto lead = static_cast<unsigned char>(value[start]);
+    const auto length = value.size() - start;
+
+    size_t expected = 0;
+    if(lead < 0x80) {
+        expected = 1;
+        code_point = lead;
+    } else if((lead & 0xE0) == 0xC0) {
+        expected = 2;
+        code_point = lead & 0x1F;
+    } else if((lead & 0xF0) == 0xE0) {
+        expected = 3;
+        code_point = lead & 0x0F;
+    } else if((lead & 0xF8) == 0xF0) {
+        expected = 4;
+        code_point = lead & 0x07;
+    } else {
+        return false;
+    }
+
+    if(length != expected)
+        return false;
+
+    for(size_t i = start + 1; i < value.size(); i++)
+        code_point = (code_point << 6) | (static_cast<unsigned char>(value[i]) & 0x3F);
+
+    return true;
+}
+
+void append_utf8(std::string& out, const uint32_t code_point)
+{
+    if(code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if(code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if(code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+} // namespace
+
+namespace query_craft {
+
+condition_group rewrite_prefix_like(const condition_group& condition, const like_diagnostics_hook& on_leading_wildcard, const bool recheck)
+{
+    if(!condition.is_valid())
+        return condition;
+
+    return condition.transform([&on_leading_wildcard, recheck](const condition_info& leaf) -> condition_group {
+        const auto& condition_operator = leaf.condition_operator();
+
+        if(condition_operator == nullptr || condition_operator->type() != operator_type::like || !leaf.need_forging())
+            return leaf;
+
+        const auto& values = leaf.values();
+        if(values.size() != 1)
+            return leaf;
+
+        const auto& pattern = values.front();
+
+        // Постоянный префикс шаблона до первого шаблонного символа
+        std::string prefix;
+        size_t position = 0;
+
+        while(position < pattern.size()) {
+            const auto ch = pattern[position];
+
+            if(ch == '\\' && position + 1 < pattern.size()) {
+                prefix.push_back(pattern[position + 1]);
+                position += 2;
+                continue;
+            }
+
+            if(ch == '%' || ch == '_')
+                break;
+
+            prefix.push_back(ch);
+            position++;
+        }
+
+        const auto& column = leaf.condition_column();
+
+        if(position == pattern.size()) {
+            if(!recheck)
+                return column == prefix;
+
+            return (column == prefix) && leaf;
+        }
+
+        if(prefix.empty()) {
+            if(on_leading_wildcard)
+                on_leading_wildcard(leaf);
+
+            return leaf;
+        }
+
+        condition_group range = column >= prefix;
+
+        std::string successor;
+        if(prefix_successor(prefix, successor))
+            range = range && (column < successor);
+
+        const auto only_percent = pattern.find_first_not_of('%', position) == std::string::npos;
+
+        if(only_percent && !recheck)
+            return range;
+
+        return range && leaf;
+    });
+}
+
+bool prefix_successor(const std::string& prefix, std::string& successor)
+{
+    auto value = prefix;
+
+    while(!value.empty()) {
+        auto start = value.size() - 1;
+        while(start > 0 && (static_cast<unsigned char>(value[start]) & 0xC0) == 0x80)
+            start--;
+
+        uint32_t code_point = 0;
+
+        if(!decode_last_char(value, start, code_point)) {
+            // Некорректная последовательность UTF-8 увеличивается побайтово
+            const auto last = static_cast<unsigned char>(value.back());
+            value.pop_back();
+
+            if(last != 0xFF) {
+                value.push_back(static_cast<char>(last + 1));
+                successor = std::move(value);
+                return true;
+            }
+
+            continue;
+        }
+
+        value.erase(start);
+
+        code_point++;
+
+        // Суррогатные пары не являются символами UTF-8
+        if(code_point == 0xD800)
+            code_point = 0xE000;
+
+        if(code_point > 0x10FFFF)
+            continue;
+
+        append_utf8(value, code_point);
+        successor = std::move(value);
+
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace query_craft
\ No newline at end of file
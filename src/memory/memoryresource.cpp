@@ -0,0 +1,187 @@
+#include "QueryCraft/memory/memoryresource.h"
+
+#include <cstdint>
+
+namespace {
+
+class new_delete_memory_resource final : public query_craft::memory::memory_resource
+{
+protected:
+    void* do_allocate(const std::size_t bytes, std::size_t) override
+    {
+        return ::operator new(bytes);
+    }
+
+    void do_deallocate(void* p, std::size_t, std::size_t) override
+    {
+        ::operator delete(p);
+    }
+
+    bool do_is_equal(const memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+thread_local query_craft::memory::memory_resource* default_resource = nullptr;
+
+/// Выравнивает указатель вверх, возвращает nullptr если выровненный блок не помещается в space
+void* align_pointer(const std::size_t alignment, const std::size_t bytes, char* ptr, const std::size_t space)
+{
+    const auto address = reinterpret_cast<std::uintptr_t>(ptr);
+    const auto padding = (alignment - address % alignment) % alignment;
+
+    if(padding > space || bytes > space - padding)
+        return nullptr;
+
+    return ptr + padding;
+}
+
+} // namespace
+
+namespace query_craft {
+namespace memory {
+
+void* memory_resource::allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    return do_allocate(bytes, alignment);
+}
+
+void memory_resource::deallocate(void* p, const std::size_t bytes, const std::size_t alignment)
+{
+    do_deallocate(p, bytes, alignment);
+}
+
+bool memory_resource::is_equal(const memory_resource& other) const noexcept
+{
+    return do_is_equal(other);
+}
+
+memory_resource* new_delete_resource() noexcept
+{
+    static new_delete_memory_resource resource;
+    return &resource;
+}
+
+memory_resource* get_default_resource() noexcept
+{
+    return default_resource == nullptr ? new_delete_resource() : default_resource;
+}
+
+memory_resource* set_default_resource(memory_resource* resource) noexcept
+{
+    auto* previous = get_default_resource();
+    default_resource = resource;
+    return previous;
+}
+
+scoped_resource::scoped_resource(memory_resource* resource) noexcept
+    : _previous(set_default_resource(resource))
+{
+}
+
+scoped_resource::~scoped_resource()
+{
+    set_default_resource(_previous);
+}
+
+monotonic_buffer_resource::monotonic_buffer_resource(memory_resource* upstream)
+    : _upstream(upstream)
+{
+}
+
+monotonic_buffer_resource::monotonic_buffer_resource(const std::size_t initial_size, memory_resource* upstream)
+    : _upstream(upstream)
+    , _next_size(initial_size == 0 ? 1 : initial_size)
+{
+}
+
+monotonic_buffer_resource::monotonic_buffer_resource(void* buffer, const std::size_t buffer_size, memory_resource* upstream)
+    : _upstream(upstream)
+    , _initial_buffer(buffer)
+    , _initial_size(buffer_size)
+    , _next_size(buffer_size == 0 ? 1024 : buffer_size * 2)
+    , _current(static_cast<char*>(buffer))
+    , _space(buffer_size)
+{
+}
+
+monotonic_buffer_resource::~monotonic_buffer_resource()
+{
+    release();
+}
+
+std::size_t monotonic_buffer_resource::outstanding() const noexcept
+{
+    return _outstanding;
+}
+
+void monotonic_buffer_resource::release() noexcept
+{
+    while(_chunks != nullptr) {
+        auto* next = _chunks->next;
+        _upstream->deallocate(_chunks, _chunks->size, alignof(std::max_align_t));
+        _chunks = next;
+    }
+
+    _current = static_cast<char*>(_initial_buffer);
+    _space = _initial_size;
+    _outstanding = 0;
+}
+
+memory_resource* monotonic_buffer_resource::upstream_resource() const
+{
+    return _upstream;
+}
+
+void* monotonic_buffer_resource::do_allocate(const std::size_t bytes, const std::size_t alignment)
+{
+    auto* result = align_pointer(alignment, bytes, _current, _space);
+
+    if(result == nullptr) {
+        grow(bytes, alignment);
+        result = align_pointer(alignment, bytes, _current, _space);
+    }
+
+    const auto used = static_cast<char*>(result) - _current + bytes;
+    _current += used;
+    _space -= used;
+    _outstanding++;
+
+    return result;
+}
+
+void monotonic_buffer_resource::do_deallocate(void*, std::size_t, std::size_t)
+{
+    // Память освобождается только целиком через release(), учитывается только количество живых блоков
+    _outstanding--;
+}
+
+bool monotonic_buffer_resource::do_is_equal(const memory_resource& other) const noexcept
+{
+    return this == &other;
+}
+
+void monotonic_buffer_resource::grow(const std::size_t bytes, const std::size_t alignment)
+{
+    const auto header_size = (sizeof(chunk) + alignof(std::max_align_t) - 1) / alignof(std::max_align_t) * alignof(std::max_align_t);
+    const auto required = header_size + bytes + alignment;
+
+    while(_next_size < required)
+        _next_size *= 2;
+
+    auto* memory = _upstream->allocate(_next_size, alignof(std::max_align_t));
+
+    auto* new_chunk = static_cast<chunk*>(memory);
+    new_chunk->next = _chunks;
+    new_chunk->size = _next_size;
+    _chunks = new_chunk;
+
+    _current = static_cast<char*>(memory) + header_size;
+    _space = _next_size - header_size;
+
+    _next_size *= 2;
+}
+
+} // namespace memory
+} // namespace query_craft
\ No newline at end of file
@@ -13,5 +13,10 @@ bool equals_operator::need_bracket() const
     return false;
 }
 
+operator_type equals_operator::type() const
+{
+    return operator_type::equals;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
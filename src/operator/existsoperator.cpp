@@ -0,0 +1,22 @@
+#include "QueryCraft/operator/existsoperator.h"
+
+namespace query_craft {
+namespace operators {
+
+std::string exists_operator::sql() const
+{
+    return "EXISTS";
+}
+
+bool exists_operator::need_bracket() const
+{
+    return true;
+}
+
+operator_type exists_operator::type() const
+{
+    return operator_type::exists;
+}
+
+} // namespace operators
+} // namespace query_craft
\ No newline at end of file
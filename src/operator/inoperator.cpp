@@ -13,5 +13,10 @@ bool in_operator::need_bracket() const
     return true;
 }
 
+operator_type in_operator::type() const
+{
+    return operator_type::in;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
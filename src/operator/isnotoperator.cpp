@@ -13,5 +13,10 @@ bool is_not_operator::need_bracket() const
     return false;
 }
 
+operator_type is_not_operator::type() const
+{
+    return operator_type::is_not;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
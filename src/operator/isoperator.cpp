@@ -13,5 +13,10 @@ bool is_operator::need_bracket() const
     return false;
 }
 
+operator_type is_operator::type() const
+{
+    return operator_type::is;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
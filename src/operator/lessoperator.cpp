@@ -13,5 +13,10 @@ bool less_operator::need_bracket() const
     return false;
 }
 
+operator_type less_operator::type() const
+{
+    return operator_type::less;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
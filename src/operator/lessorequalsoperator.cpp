@@ -13,5 +13,10 @@ bool less_or_equals_operator::need_bracket() const
     return false;
 }
 
+operator_type less_or_equals_operator::type() const
+{
+    return operator_type::less_or_equals;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
@@ -13,5 +13,10 @@ bool like_operator::need_bracket() const
     return false;
 }
 
+operator_type like_operator::type() const
+{
+    return operator_type::like;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
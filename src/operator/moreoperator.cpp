@@ -13,5 +13,10 @@ bool more_operator::need_bracket() const
     return false;
 }
 
+operator_type more_operator::type() const
+{
+    return operator_type::more;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
@@ -13,5 +13,10 @@ bool not_equals_operator::need_bracket() const
     return false;
 }
 
+operator_type not_equals_operator::type() const
+{
+    return operator_type::not_equals;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,22 @@
+#include "QueryCraft/operator/notexistsoperator.h"
+
+namespace query_craft {
+namespace operators {
+
+std::string not_exists_operator::sql() const
+{
+    return "NOT EXISTS";
+}
+
+bool not_exists_operator::need_bracket() const
+{
+    return true;
+}
+
+operator_type not_exists_operator::type() const
+{
+    return operator_type::not_exists;
+}
+
+} // namespace operators
+} // namespace query_craft
\ No newline at end of file
@@ -13,5 +13,10 @@ bool not_in_operator::need_bracket() const
     return true;
 }
 
+operator_type not_in_operator::type() const
+{
+    return operator_type::not_in;
+}
+
 } // namespace operators
 } // namespace query_craft
\ No newline at end of file
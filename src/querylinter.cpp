@@ -0,0 +1,155 @@
+#include "QueryCraft/querylinter.h"
+
+#include <stdexcept>
+
+namespace query_craft {
+
+query_linter::query_linter(settings settings)
+    : _settings(std::move(settings))
+{
+}
+
+std::vector<lint_warning> query_linter::check_select(
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    const size_t limit,
+    const size_t offset) const
+{
+    auto warnings = check_condition(condition);
+
+    for(const auto& join : join_columns) {
+        if(join.condition.is_valid())
+            check_tree(join.condition, warnings);
+    }
+
+    if(offset >= _settings.max_offset) {
+        warnings.push_back({ lint_warning::severity::warning,
+            lint_warning::kind::large_offset,
+            "OFFSET " + std::to_string(offset) + " читает и отбрасывает все пропущенные строки, используйте постраничную выборку по ключу" });
+    }
+
+    for(const auto& sort : sort_columns) {
+        if(sort.column.name().empty() && sort.column.alias() == random_sort().column.alias()) {
+            warnings.push_back({ lint_warning::severity::warning,
+                lint_warning::kind::random_sort,
+                "ORDER BY RANDOM () сортирует всю выборку, используйте sample_select_sql или random_keys_select_sql" });
+        }
+    }
+
+    if(_settings.require_limit && limit == 0 && !pins_primary_key(condition)) {
+        warnings.push_back({ lint_warning::severity::info,
+            lint_warning::kind::missing_limit,
+            "Выборка без LIMIT возвращает все подходящие строки" });
+    }
+
+    return warnings;
+}
+
+std::vector<lint_warning> query_linter::check_update(const condition_group& condition) const
+{
+    return check_write(condition, "UPDATE");
+}
+
+std::vector<lint_warning> query_linter::check_remove(const condition_group& condition) const
+{
+    return check_write(condition, "DELETE");
+}
+
+std::vector<lint_warning> query_linter::check_condition(const condition_group& condition) const
+{
+    std::vector<lint_warning> warnings;
+
+    if(condition.is_valid())
+        check_tree(condition, warnings);
+
+    return warnings;
+}
+
+void query_linter::check_tree(const condition_group& node, std::vector<lint_warning>& warnings) const
+{
+    if(!node.is_leaf()) {
+        if(node.left() != nullptr)
+            check_tree(*node.left(), warnings);
+
+        if(node.right() != nullptr)
+            check_tree(*node.right(), warnings);
+
+        return;
+    }
+
+    const auto& leaf = node.leaf();
+    const auto& condition_operator = leaf.condition_operator();
+
+    if(condition_operator == nullptr || !leaf.need_forging())
+        return;
+
+    const auto& values = leaf.values();
+
+    switch(condition_operator->type()) {
+        case operator_type::like: {
+            if(!values.empty() && !values.front().empty() && (values.front().front() == '%' || values.front().front() == '_')) {
+                warnings.push_back({ lint_warning::severity::warning,
+                    lint_warning::kind::leading_wildcard,
+                    leaf.unwrap(condion_view_type::full_name) + " не может использовать индекс, так как шаблон начинается с шаблонного символа" });
+            }
+            break;
+        }
+
+        case operator_type::in:
+        case operator_type::not_in: {
+            if(values.size() >= _settings.max_in_list) {
+                warnings.push_back({ lint_warning::severity::warning,
+                    lint_warning::kind::large_in_list,
+                    "Список " + condition_operator->sql() + " для " + leaf.condition_column().full_name() + " содержит "
+                        + std::to_string(values.size()) + " значений, используйте разбиение на части или временную таблицу" });
+            }
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+std::vector<lint_warning> query_linter::check_write(const condition_group& condition, const char* statement) const
+{
+    if(condition.is_valid())
+        return check_condition(condition);
+
+    const auto message = std::string(statement) + " без условия изменяет все строки таблицы";
+
+    if(_settings.strict)
+        throw std::logic_error("Ошибка. " + message);
+
+    return { { lint_warning::severity::error, lint_warning::kind::full_table_write, message } };
+}
+
+bool query_linter::pins_primary_key(const condition_group& node)
+{
+    if(!node.is_valid())
+        return false;
+
+    if(!node.is_leaf()) {
+        if(node.left() == nullptr || node.right() == nullptr)
+            return false;
+
+        if(node.group_operator() == logical_operator::and_)
+            return pins_primary_key(*node.left()) || pins_primary_key(*node.right());
+
+        return pins_primary_key(*node.left()) && pins_primary_key(*node.right());
+    }
+
+    const auto& leaf = node.leaf();
+    const auto& condition_operator = leaf.condition_operator();
+
+    if(condition_operator == nullptr || !leaf.need_forging())
+        return false;
+
+    const auto type = condition_operator->type();
+
+    return (type == operator_type::equals || type == operator_type::in)
+        && leaf.condition_column().has_settings(column_settings::primary_key);
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "QueryCraft/rowbatch.h"
+
+#include "QueryCraft/helper/sqlrenderer.h"
+
+namespace query_craft {
+
+shared_schema make_shared_schema(const table& table)
+{
+    return std::make_shared<const sql_table>(table);
+}
+
+row_batch::row_batch(shared_schema schema)
+    : _schema(std::move(schema))
+{
+    if(_schema == nullptr)
+        throw std::invalid_argument("Ошибка. Отсутствует описание таблицы");
+}
+
+row_batch& row_batch::add_row(const row& row)
+{
+    check_row(row);
+
+    _rows.push_back(row);
+    return *this;
+}
+
+row_batch& row_batch::add_row(row&& row)
+{
+    check_row(row);
+
+    _rows.push_back(std::move(row));
+    return *this;
+}
+
+std::string row_batch::insert_sql(array_view<column_info> columns, const bool need_returning, array_view<column_info> returning_columns)
+{
+    auto sql = helper::insert_sql(*_schema, _rows, columns, need_returning, returning_columns);
+
+    _rows.clear();
+
+    return sql;
+}
+
+std::string row_batch::update_sql(const condition_group& condition, array_view<column_info> columns)
+{
+    auto sql = helper::update_sql(*_schema, _rows, condition, columns);
+
+    _rows.clear();
+
+    return sql;
+}
+
+void row_batch::clear()
+{
+    _rows.clear();
+}
+
+size_t row_batch::size() const
+{
+    return _rows.size();
+}
+
+bool row_batch::empty() const
+{
+    return _rows.empty();
+}
+
+const sql_table& row_batch::schema() const
+{
+    return *_schema;
+}
+
+void row_batch::check_row(const row& row) const
+{
+    if(row.empty())
+        throw std::logic_error("Ошибка. Попытка добавить пустую строку");
+
+    if(!_rows.empty() && _rows.begin()->size() != row.size())
+        throw std::logic_error("Ошибка. Не совпадает размер строки с уже добавленными в таблицу");
+}
+
+} // namespace query_craft
\ No newline at end of file
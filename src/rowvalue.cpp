@@ -0,0 +1,23 @@
+#include "QueryCraft/rowvalue.h"
+
+namespace query_craft {
+namespace helper {
+
+size_t append_row_value(std::string& out, const std::vector<std::string>& values)
+{
+    out.append("(");
+
+    for(auto it = values.begin(); it != values.end(); ++it) {
+        if(it != values.begin())
+            out.append(", ");
+
+        append_escaped_value(out, *it);
+    }
+
+    out.append(")");
+
+    return values.size();
+}
+
+} // namespace helper
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,169 @@
+#include "QueryCraft/selectquery.h"
+
+#include "QueryCraft/helper/sqlrenderer.h"
+
+namespace query_craft {
+
+constexpr size_t select_query::clause_count;
+
+select_query::select_query(table source)
+{
+    _description.source = std::move(source);
+}
+
+select_query::select_query(select_description description)
+    : _description(std::move(description))
+{
+}
+
+select_query& select_query::from(table source)
+{
+    _description.source = std::move(source);
+
+    // Список столбцов по умолчанию зависит от таблицы
+    if(_description.columns.empty())
+        invalidate(clause::select_list);
+
+    invalidate(clause::from);
+
+    return *this;
+}
+
+select_query& select_query::join(join_column join)
+{
+    _description.joins.push_back(std::move(join));
+    invalidate(clause::joins);
+
+    return *this;
+}
+
+select_query& select_query::joins(std::vector<join_column> joins)
+{
+    _description.joins = std::move(joins);
+    invalidate(clause::joins);
+
+    return *this;
+}
+
+select_query& select_query::where(condition_group condition)
+{
+    _description.condition = std::move(condition);
+    invalidate(clause::where);
+
+    return *this;
+}
+
+select_query& select_query::order_by(std::vector<sort_column> sorts)
+{
+    _description.sorts = std::move(sorts);
+    invalidate(clause::order_by);
+
+    return *this;
+}
+
+select_query& select_query::limit(const size_t limit)
+{
+    if(_description.limit != limit) {
+        _description.limit = limit;
+        invalidate(clause::limit_offset);
+    }
+
+    return *this;
+}
+
+select_query& select_query::offset(const size_t offset)
+{
+    if(_description.offset != offset) {
+        _description.offset = offset;
+        invalidate(clause::limit_offset);
+    }
+
+    return *this;
+}
+
+select_query& select_query::columns(std::vector<column_info> columns)
+{
+    _description.columns = std::move(columns);
+    invalidate(clause::select_list);
+
+    return *this;
+}
+
+const std::string& select_query::sql()
+{
+    if(_first_changed == clause_count)
+        return _sql;
+
+    // Части до первой измененной уже находятся в _sql, остальные копируются из запомненных фрагментов
+    _sql.erase(_offsets[_first_changed]);
+
+    for(auto i = _first_changed; i < clause_count; i++) {
+        if((_dirty & (1 << i)) != 0)
+            render(static_cast<clause>(i));
+
+        _offsets[i] = _sql.size();
+        _sql.append(_fragments[i]);
+    }
+
+    _sql.append(";");
+
+    _dirty = 0;
+    _first_changed = clause_count;
+
+    return _sql;
+}
+
+void select_query::sql(std::string& out)
+{
+    out.append(sql());
+}
+
+select_description select_query::description() const
+{
+    return _description;
+}
+
+void select_query::invalidate(const clause part)
+{
+    const auto index = static_cast<size_t>(part);
+
+    _dirty |= static_cast<uint8_t>(1 << index);
+
+    if(index < _first_changed)
+        _first_changed = index;
+}
+
+void select_query::render(const clause part)
+{
+    auto& out = _fragments[static_cast<size_t>(part)];
+    out.clear();
+
+    switch(part) {
+        case clause::select_list:
+            out.append("SELECT ");
+            helper::append_select_list(out, _description.columns.empty() ? _description.source.columns() : _description.columns);
+            break;
+
+        case clause::from:
+            out.append(" FROM ").append(_description.source.table_name());
+            break;
+
+        case clause::joins:
+            helper::append_joins(out, _description.joins);
+            break;
+
+        case clause::where:
+            helper::append_where(out, _description.condition, condion_view_type::full_name);
+            break;
+
+        case clause::order_by:
+            helper::append_order_by(out, _description.sorts);
+            break;
+
+        case clause::limit_offset:
+            helper::append_limit_offset(out, _description.limit, _description.offset);
+            break;
+    }
+}
+
+} // namespace query_craft
\ No newline at end of file
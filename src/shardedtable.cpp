@@ -0,0 +1,348 @@
+#include "QueryCraft/shardedtable.h"
+
+#include <algorithm>
+#include <string>
+
+namespace query_craft {
+
+shard_router hash_router(const size_t shard_count)
+{
+    if(shard_count == 0)
+        throw std::invalid_argument("Ошибка. Количество шардов должно быть больше нуля");
+
+    return [shard_count](const std::string& key_value) {
+        uint64_t hash = 14695981039346656037ull;
+
+        for(const auto ch : key_value) {
+            hash ^= static_cast<unsigned char>(ch);
+            hash *= 1099511628211ull;
+        }
+
+        return static_cast<size_t>(hash % shard_count);
+    };
+}
+
+shard_router range_router(std::vector<long long> boundaries)
+{
+    if(!std::is_sorted(boundaries.begin(), boundaries.end()))
+        throw std::invalid_argument("Ошибка. Границы диапазонов должны возрастать");
+
+    return [boundaries](const std::string& key_value) {
+        if(key_value == column_info::null_value())
+            return static_cast<size_t>(0);
+
+        const auto key = std::stoll(key_value);
+        return static_cast<size_t>(std::upper_bound(boundaries.begin(), boundaries.end(), key) - boundaries.begin());
+    };
+}
+
+sharded_table::sharded_table(const table& logical, const size_t shard_count, const std::string& key_column, shard_router router)
+    : _logical(logical)
+    , _key_column(key_column)
+    , _router(std::move(router))
+{
+    if(shard_count == 0)
+        throw std::invalid_argument("Ошибка. Количество шардов должно быть больше нуля");
+
+    const auto& columns = logical.columns();
+
+    for(size_t i = 0; i < shard_count; i++) {
+        table shard(logical.name() + "_" + std::to_string(i), logical.scheme(), columns.begin(), columns.end());
+        _shards.push_back(std::make_shared<const sql_table>(std::move(shard)));
+    }
+
+    init();
+}
+
+sharded_table::sharded_table(const table& logical, const std::vector<table>& shards, const std::string& key_column, shard_router router)
+    : _logical(logical)
+    , _key_column(key_column)
+    , _router(std::move(router))
+{
+    if(shards.empty())
+        throw std::invalid_argument("Ошибка. Количество шардов должно быть больше нуля");
+
+    for(const auto& shard : shards) {
+        if(shard.columns().size() != logical.columns().size())
+            throw std::invalid_argument("Ошибка. Столбцы шарда не совпадают со столбцами логической таблицы");
+
+        for(const auto& column : logical.columns())
+            shard.column(column.name());
+
+        _shards.push_back(make_shared_schema(shard));
+    }
+
+    init();
+}
+
+sharded_table& sharded_table::add_row(const row& row)
+{
+    if(row.size() != _logical.columns().size())
+        throw std::logic_error("Ошибка. Не совпадает размер строки с количеством колонок");
+
+    _batches[route(row[_key_index])].add_row(row);
+
+    return *this;
+}
+
+sharded_table& sharded_table::add_row(row&& row)
+{
+    if(row.size() != _logical.columns().size())
+        throw std::logic_error("Ошибка. Не совпадает размер строки с количеством колонок");
+
+    auto& batch = _batches[route(row[_key_index])];
+    batch.add_row(std::move(row));
+
+    return *this;
+}
+
+std::vector<sharded_table::statement> sharded_table::insert_sql(const bool need_returning, array_view<column_info> returning_columns)
+{
+    std::vector<statement> statements;
+
+    for(size_t i = 0; i < _batches.size(); i++) {
+        if(_batches[i].empty())
+            continue;
+
+        // Строки следуют порядку столбцов логической таблицы, который совпадает с порядком столбцов шарда
+        statements.push_back({ i, _batches[i].insert_sql(_logical.columns(), need_returning, returning_columns) });
+    }
+
+    return statements;
+}
+
+std::vector<size_t> sharded_table::target_shards(const condition_group& condition) const
+{
+    std::vector<size_t> shards;
+
+    if(!condition.is_valid()) {
+        for(size_t i = 0; i < _shards.size(); i++)
+            shards.push_back(i);
+
+        return shards;
+    }
+
+    const auto mask = shard_mask(condition);
+    for(size_t i = 0; i < mask.size(); i++) {
+        if(mask[i])
+            shards.push_back(i);
+    }
+
+    return shards;
+}
+
+std::vector<sharded_table::statement> sharded_table::select_sql(
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    const size_t limit,
+    const size_t offset,
+    array_view<column_info> columns) const
+{
+    const auto shards = target_shards(condition);
+    const auto fan_out = shards.size() > 1;
+
+    std::vector<statement> statements;
+    statements.reserve(shards.size());
+
+    for(const auto index : shards) {
+        const auto& shard = *_shards[index];
+
+        auto shard_joins = join_columns.to_vector();
+        for(auto& join : shard_joins)
+            join.condition = map_condition(join.condition, shard);
+
+        auto shard_sorts = sort_columns.to_vector();
+        for(auto& sort : shard_sorts)
+            sort.column = map_column(sort.column, shard);
+
+        std::vector<column_info> shard_columns;
+        shard_columns.reserve(columns.size());
+        for(const auto& column : columns)
+            shard_columns.push_back(map_column(column, shard));
+
+        const auto shard_limit = fan_out && limit != 0 ? limit + offset : limit;
+        const auto shard_offset = fan_out ? 0 : offset;
+
+        statements.push_back({ index, shard.select_sql(shard_joins, map_condition(condition, shard), shard_sorts, shard_limit, shard_offset, shard_columns) });
+    }
+
+    return statements;
+}
+
+std::vector<sharded_table::statement> sharded_table::remove_sql(const condition_group& condition) const
+{
+    std::vector<statement> statements;
+
+    for(const auto index : target_shards(condition)) {
+        const auto& shard = *_shards[index];
+        statements.push_back({ index, shard.remove_sql(map_condition(condition, shard)) });
+    }
+
+    return statements;
+}
+
+column_info sharded_table::column(const std::string& name) const
+{
+    return _logical.column(name);
+}
+
+const table& sharded_table::logical_table() const
+{
+    return _logical;
+}
+
+const sql_table& sharded_table::shard(const size_t index) const
+{
+    if(index >= _shards.size())
+        throw std::invalid_argument("Ошибка. Неправильный номер шарда");
+
+    return *_shards[index];
+}
+
+size_t sharded_table::shard_count() const
+{
+    return _shards.size();
+}
+
+size_t sharded_table::pending_rows() const
+{
+    size_t count = 0;
+    for(const auto& batch : _batches)
+        count += batch.size();
+
+    return count;
+}
+
+void sharded_table::init()
+{
+    const auto& columns = _logical.columns();
+
+    const auto key_it = std::find_if(columns.begin(), columns.end(), [this](const column_info& column) {
+        return column.name() == _key_column;
+    });
+
+    if(key_it == columns.end())
+        throw std::invalid_argument("Ошибка. Ключевой столбец отсутствует в таблице");
+
+    _key_index = static_cast<size_t>(key_it - columns.begin());
+
+    if(!_router)
+        _router = hash_router(_shards.size());
+
+    for(const auto& column : columns)
+        _logical_full_names.emplace(column.full_name(), column.name());
+
+    _batches.reserve(_shards.size());
+    for(const auto& shard : _shards)
+        _batches.emplace_back(shard);
+}
+
+size_t sharded_table::route(const std::string& key_value) const
+{
+    const auto index = _router(key_value);
+
+    if(index >= _shards.size())
+        throw std::logic_error("Ошибка. Функция распределения вернула несуществующий шард");
+
+    return index;
+}
+
+std::vector<bool> sharded_table::shard_mask(const condition_group& node) const
+{
+    if(!node.is_leaf()) {
+        auto mask = node.left() != nullptr ? shard_mask(*node.left()) : std::vector<bool>(_shards.size(), true);
+        const auto right = node.right() != nullptr ? shard_mask(*node.right()) : std::vector<bool>(_shards.size(), true);
+
+        for(size_t i = 0; i < mask.size(); i++)
+            mask[i] = node.group_operator() == logical_operator::and_ ? mask[i] && right[i] : mask[i] || right[i];
+
+        return mask;
+    }
+
+    const auto& leaf = node.leaf();
+    const auto& key_name = _logical.columns()[_key_index].full_name();
+
+    const auto& op = leaf.condition_operator();
+    const auto is_key_literal = op != nullptr && leaf.need_forging() && leaf.condition_column().full_name() == key_name;
+
+    if(!is_key_literal)
+        return std::vector<bool>(_shards.size(), true);
+
+    const auto& values = leaf.values();
+
+    switch(op->type()) {
+        case operator_type::equals:
+        case operator_type::in:
+        case operator_type::is: {
+            // Условие "IS NOT NULL" имеет другой тип оператора, поэтому сюда попадает только "IS NULL"
+            std::vector<bool> mask(_shards.size(), false);
+            for(const auto& value : values)
+                mask[route(value)] = true;
+
+            return mask;
+        }
+        default:
+            return std::vector<bool>(_shards.size(), true);
+    }
+}
+
+column_info sharded_table::map_column(const column_info& column, const sql_table& shard) const
+{
+    const auto it = _logical_full_names.find(column.full_name());
+
+    if(it == _logical_full_names.end())
+        return column;
+
+    // Псевдоним логической таблицы сохраняется, чтобы результаты всех шардов имели одинаковые имена столбцов
+    auto shard_column = shard.column(it->second);
+    shard_column.set_alias(column.alias());
+
+    return shard_column;
+}
+
+condition_group sharded_table::map_condition(const condition_group& condition, const sql_table& shard) const
+{
+    if(!condition.is_valid())
+        return condition;
+
+    return condition.transform([this, &shard](const condition_info& leaf) -> condition_group {
+        if(!leaf.row_columns().empty()) {
+            std::vector<column_info> row_columns;
+            for(const auto& row_column : leaf.row_columns())
+                row_columns.push_back(map_column(row_column, shard));
+
+            return condition_info::row_in(std::move(row_columns), leaf.values());
+        }
+
+        auto result = leaf.with_column(map_column(leaf.condition_column(), shard));
+
+        if(leaf.need_forging())
+            return result;
+
+        const auto& condition_operator = leaf.condition_operator();
+        const auto type = condition_operator != nullptr ? condition_operator->type() : operator_type::custom;
+
+        if(type == operator_type::in || type == operator_type::not_in || type == operator_type::exists || type == operator_type::not_exists) {
+            // Текст вложенного запроса уже сгенерирован, и заменить в нем логическую таблицу на шард нельзя
+            for(const auto& value : leaf.values()) {
+                if(value.find(_logical.table_name()) != std::string::npos)
+                    throw std::invalid_argument("Ошибка. Вложенный запрос к логической таблице не может быть перенесен на шард");
+            }
+
+            return result;
+        }
+
+        // Значения без экранирования могут ссылаться на столбцы логической таблицы
+        auto values = leaf.values();
+        for(auto& value : values) {
+            const auto it = _logical_full_names.find(value);
+            if(it != _logical_full_names.end())
+                value = shard.column(it->second).full_name();
+        }
+
+        return result.with_values(std::move(values));
+    });
+}
+
+} // namespace query_craft
\ No newline at end of file
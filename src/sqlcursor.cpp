@@ -0,0 +1,84 @@
+#include "QueryCraft/sqlcursor.h"
+
+#include "QueryCraft/helper/sqlrenderer.h"
+
+namespace query_craft {
+
+sql_cursor::sql_cursor(std::string name, sub_query query, const scope cursor_scope, const bool scroll)
+    : _name(std::move(name))
+    , _query(std::move(query))
+    , _scope(cursor_scope)
+    , _scroll(scroll)
+{
+    if(_name.empty())
+        throw std::invalid_argument("Ошибка. Пустое имя курсора");
+
+    if(!_query.is_valid())
+        throw std::invalid_argument("Ошибка. Пустой запрос курсора");
+}
+
+std::string sql_cursor::open_sql() const
+{
+    std::string sql;
+    sql.append("DECLARE ");
+    append_name(sql);
+    sql.append(_scroll ? " SCROLL CURSOR" : " NO SCROLL CURSOR");
+
+    if(_scope == scope::with_hold)
+        sql.append(" WITH HOLD");
+
+    sql.append(" FOR ").append(_query.sql()).append(";");
+
+    return sql;
+}
+
+std::string sql_cursor::fetch_sql(const size_t count) const
+{
+    if(count == 0)
+        throw std::invalid_argument("Ошибка. Размер пачки должен быть больше нуля");
+
+    std::string sql;
+    sql.append("FETCH FORWARD ");
+    helper::append_number(sql, count);
+    sql.append(" FROM ");
+    append_name(sql);
+    sql.append(";");
+
+    return sql;
+}
+
+std::string sql_cursor::close_sql() const
+{
+    std::string sql;
+    sql.append("CLOSE ");
+    append_name(sql);
+    sql.append(";");
+
+    return sql;
+}
+
+const std::string& sql_cursor::name() const
+{
+    return _name;
+}
+
+bool sql_cursor::requires_transaction() const
+{
+    return _scope == scope::transaction;
+}
+
+void sql_cursor::append_name(std::string& out) const
+{
+    out.append("\"");
+
+    for(const auto ch : _name) {
+        if(ch == '"')
+            out.push_back('"');
+
+        out.push_back(ch);
+    }
+
+    out.append("\"");
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,286 @@
+#include "QueryCraft/sqlite/sqliteexecutor.h"
+
+#include <sqlite3.h>
+
+#include <cctype>
+#include <memory>
+#include <utility>
+
+namespace {
+
+/// Освобождает подготовленный запрос при выходе из области видимости.
+struct statement_deleter
+{
+    void operator()(sqlite3_stmt* statement) const
+    {
+        sqlite3_finalize(statement);
+    }
+};
+
+using statement_ptr = std::unique_ptr<sqlite3_stmt, statement_deleter>;
+
+void append_quoted_name(std::string& out, const std::string& name)
+{
+    out.push_back('"');
+
+    for(const auto ch : name) {
+        if(ch == '"')
+            out.push_back('"');
+
+        out.push_back(ch);
+    }
+
+    out.push_back('"');
+}
+
+} // namespace
+
+namespace query_craft {
+namespace sqlite {
+
+constexpr size_t error::npos;
+
+error::error(const std::string& message, const int code, const size_t offset)
+    : std::runtime_error(message)
+    , _code(code)
+    , _offset(offset)
+{
+}
+
+int error::code() const noexcept
+{
+    return _code;
+}
+
+size_t error::offset() const noexcept
+{
+    return _offset;
+}
+
+executor::executor(const std::string& path)
+{
+    const auto code = sqlite3_open(path.c_str(), &_db);
+
+    if(code != SQLITE_OK) {
+        const std::string message = _db != nullptr ? sqlite3_errmsg(_db) : sqlite3_errstr(code);
+
+        sqlite3_close(_db);
+        _db = nullptr;
+
+        throw error("Ошибка. Не удалось открыть базу данных SQLite: " + message, code);
+    }
+}
+
+executor::executor(executor&& other) noexcept
+    : _db(other._db)
+{
+    other._db = nullptr;
+}
+
+executor& executor::operator=(executor&& other) noexcept
+{
+    if(this != &other) {
+        sqlite3_close(_db);
+
+        _db = other._db;
+        other._db = nullptr;
+    }
+
+    return *this;
+}
+
+executor::~executor()
+{
+    sqlite3_close(_db);
+}
+
+void executor::attach(const std::string& scheme, const std::string& path)
+{
+    std::string sql = "ATTACH DATABASE ";
+    sql.push_back('\'');
+
+    for(const auto ch : path) {
+        if(ch == '\'')
+            sql.push_back('\'');
+
+        sql.push_back(ch);
+    }
+
+    sql.append("' AS ");
+    append_quoted_name(sql, scheme);
+    sql.push_back(';');
+
+    execute(sql);
+}
+
+void executor::create_table(const table& schema, const std::string& column_type)
+{
+    const auto& scheme = schema.scheme();
+
+    // sqlite3_db_filename возвращает nullptr для неподключенной базы данных
+    if(!scheme.empty() && sqlite3_db_filename(_db, scheme.c_str()) == nullptr)
+        attach(scheme);
+
+    const auto& columns = schema.columns();
+
+    size_t primary_keys = 0;
+    for(const auto& column : columns) {
+        if(column.has_settings(column_settings::primary_key))
+            primary_keys++;
+    }
+
+    std::string sql = "CREATE TABLE IF NOT EXISTS ";
+
+    if(!scheme.empty()) {
+        append_quoted_name(sql, scheme);
+        sql.push_back('.');
+    }
+
+    append_quoted_name(sql, schema.name());
+    sql.append(" (");
+
+    for(size_t i = 0; i < columns.size(); i++) {
+        const auto& column = columns[i];
+
+        if(i != 0)
+            sql.append(", ");
+
+        append_quoted_name(sql, column.name());
+
+        const auto is_primary_key = column.has_settings(column_settings::primary_key);
+
+        // Только INTEGER PRIMARY KEY становится псевдонимом rowid и заполняется автоматически
+        if(is_primary_key && primary_keys == 1 && column.has_settings(column_settings::auto_increment)) {
+            sql.append(" INTEGER PRIMARY KEY");
+            continue;
+        }
+
+        if(!column_type.empty())
+            sql.append(" ").append(column_type);
+
+        if(is_primary_key && primary_keys == 1)
+            sql.append(" PRIMARY KEY");
+
+        if(column.has_settings(column_settings::not_null))
+            sql.append(" NOT NULL");
+    }
+
+    if(primary_keys > 1) {
+        sql.append(", PRIMARY KEY (");
+
+        bool first = true;
+        for(const auto& column : columns) {
+            if(!column.has_settings(column_settings::primary_key))
+                continue;
+
+            if(!first)
+                sql.append(", ");
+
+            append_quoted_name(sql, column.name());
+            first = false;
+        }
+
+        sql.push_back(')');
+    }
+
+    sql.append(");");
+
+    execute(sql);
+}
+
+size_t executor::execute(const std::string& sql)
+{
+    const auto before = sqlite3_total_changes(_db);
+    run(sql, nullptr);
+
+    return static_cast<size_t>(sqlite3_total_changes(_db) - before);
+}
+
+std::vector<executor::row> executor::query(const std::string& sql)
+{
+    std::vector<row> rows;
+    const row_handler handler = [&rows](const row& row) { rows.push_back(row); };
+
+    run(sql, &handler);
+
+    return rows;
+}
+
+size_t executor::query(const std::string& sql, const row_handler& handler)
+{
+    return run(sql, &handler);
+}
+
+sqlite3* executor::handle() const noexcept
+{
+    return _db;
+}
+
+size_t executor::run(const std::string& sql, const row_handler* handler)
+{
+    const auto* const begin = sql.data();
+    const auto* const end = begin + sql.size();
+    const auto* tail = begin;
+
+    size_t rows = 0;
+    row values;
+
+    while(tail != end) {
+        // Смещение запроса указывает на его первый символ, а не на разделитель перед ним
+        while(tail != end && std::isspace(static_cast<unsigned char>(*tail)))
+            tail++;
+
+        if(tail == end)
+            break;
+
+        const auto offset = static_cast<size_t>(tail - begin);
+
+        // Длина передается вместе с завершающим нулем std::string, иначе SQLite копирует весь остаток текста для каждого запроса
+        sqlite3_stmt* prepared = nullptr;
+        const auto prepare_code = sqlite3_prepare_v2(_db, tail, static_cast<int>(end - tail + 1), &prepared, &tail);
+        statement_ptr statement(prepared);
+
+        if(prepare_code != SQLITE_OK)
+            fail(prepare_code, offset);
+
+        // Пустой запрос, например комментарий
+        if(statement == nullptr)
+            continue;
+
+        int code;
+        while((code = sqlite3_step(statement.get())) == SQLITE_ROW) {
+            rows++;
+
+            if(handler == nullptr)
+                continue;
+
+            const auto count = sqlite3_column_count(statement.get());
+            values.resize(static_cast<size_t>(count));
+
+            for(int i = 0; i < count; i++) {
+                const auto* text = reinterpret_cast<const char*>(sqlite3_column_text(statement.get(), i));
+
+                if(text == nullptr) {
+                    values[i] = column_info::null_value();
+                } else {
+                    values[i].assign(text, static_cast<size_t>(sqlite3_column_bytes(statement.get(), i)));
+                }
+            }
+
+            (*handler)(values);
+        }
+
+        if(code != SQLITE_DONE)
+            fail(code, offset);
+    }
+
+    return rows;
+}
+
+void executor::fail(const int code, const size_t offset) const
+{
+    throw error("Ошибка. SQLite: " + std::string(sqlite3_errmsg(_db)), code, offset);
+}
+
+} // namespace sqlite
+} // namespace query_craft
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "QueryCraft/sqlscript.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+constexpr char begin_statement_sql[] = "BEGIN;";
+constexpr char commit_statement_sql[] = "COMMIT;";
+
+} // namespace
+
+namespace query_craft {
+
+constexpr size_t sql_script::npos;
+
+sql_script::sql_script()
+    : sql_script(settings())
+{
+}
+
+sql_script::sql_script(settings settings)
+    : _settings(std::move(settings))
+{
+    clear();
+}
+
+bool sql_script::add(const std::string& statement)
+{
+    const auto start = begin_statement();
+    _script.append(statement);
+
+    return end_statement(start, statement_kind::statement);
+}
+
+bool sql_script::savepoint(const std::string& name)
+{
+    return add_control("SAVEPOINT ", name);
+}
+
+bool sql_script::release_savepoint(const std::string& name)
+{
+    return add_control("RELEASE SAVEPOINT ", name);
+}
+
+bool sql_script::rollback_to_savepoint(const std::string& name)
+{
+    return add_control("ROLLBACK TO SAVEPOINT ", name);
+}
+
+const std::string& sql_script::sql()
+{
+    if(_finished)
+        return _script;
+
+    if(_settings.transaction) {
+        // Место под COMMIT учитывается при каждом добавлении, поэтому ограничение размера здесь не проверяется
+        _script.append("\n");
+        _statements.push_back({ _script.size(), sizeof(commit_statement_sql) - 1, statement_kind::control });
+        _script.append(commit_statement_sql);
+    }
+
+    _finished = true;
+
+    return _script;
+}
+
+std::string sql_script::statement_sql(const size_t index) const
+{
+    const auto& statement = _statements.at(index);
+
+    return _script.substr(statement.offset, statement.size);
+}
+
+const std::vector<sql_script::statement_info>& sql_script::statements() const
+{
+    return _statements;
+}
+
+size_t sql_script::find_statement(const size_t position) const
+{
+    // Запросы следуют по возрастанию смещения, ищется последний запрос, начинающийся не позже позиции
+    const auto it = std::upper_bound(_statements.begin(), _statements.end(), position, [](const size_t value, const statement_info& statement) {
+        return value < statement.offset;
+    });
+
+    if(it == _statements.begin())
+        return npos;
+
+    const auto& statement = *(it - 1);
+    if(position >= statement.offset + statement.size)
+        return npos;
+
+    return static_cast<size_t>(it - 1 - _statements.begin());
+}
+
+const std::string& sql_script::rejected() const
+{
+    return _rejected;
+}
+
+size_t sql_script::size() const
+{
+    return _count;
+}
+
+bool sql_script::empty() const
+{
+    return _count == 0;
+}
+
+void sql_script::clear()
+{
+    _script.clear();
+    _rejected.clear();
+    _statements.clear();
+    _count = 0;
+    _finished = false;
+
+    if(_settings.transaction) {
+        _statements.push_back({ 0, sizeof(begin_statement_sql) - 1, statement_kind::control });
+        _script.append(begin_statement_sql);
+    }
+}
+
+size_t sql_script::begin_statement()
+{
+    if(_finished)
+        throw std::logic_error("Ошибка. Скрипт уже завершен, для повторного использования вызовите clear()");
+
+    const auto start = _script.size();
+
+    if(!_script.empty())
+        _script.append("\n");
+
+    return start;
+}
+
+bool sql_script::end_statement(const size_t start, const statement_kind kind)
+{
+    // Перед каждым запросом, кроме первого, добавлен перевод строки
+    const auto offset = start == 0 ? start : start + 1;
+
+    if(_script.size() > offset && _script.back() != ';')
+        _script.append(";");
+
+    if(_script.size() == offset) {
+        _script.erase(start);
+        throw std::invalid_argument("Ошибка. Попытка добавить пустой запрос");
+    }
+
+    if(_settings.max_size != 0 && _script.size() + closing_size() > _settings.max_size) {
+        _rejected.assign(_script, offset, std::string::npos);
+        _script.erase(start);
+
+        return false;
+    }
+
+    _statements.push_back({ offset, _script.size() - offset, kind });
+
+    if(kind == statement_kind::statement)
+        _count++;
+
+    return true;
+}
+
+bool sql_script::add_control(const char* prefix, const std::string& name)
+{
+    if(name.empty())
+        throw std::invalid_argument("Ошибка. Пустое имя точки сохранения");
+
+    const auto start = begin_statement();
+    _script.append(prefix).append("\"");
+
+    for(const auto ch : name) {
+        if(ch == '"')
+            _script.push_back('"');
+
+        _script.push_back(ch);
+    }
+
+    _script.append("\";");
+
+    return end_statement(start, statement_kind::control);
+}
+
+size_t sql_script::closing_size() const
+{
+    return _settings.transaction ? sizeof(commit_statement_sql) : 0;
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -1,43 +1,13 @@
 #include "QueryCraft/sqltable.h"
 
-namespace {
-void insert_with_escaping_character(std::stringstream& sql_stream, const std::string& value)
-{
-    if(value != query_craft::column_info::null_value()) {
-        sql_stream << "'";
-    }
+#include "QueryCraft/helper/sqlrenderer.h"
 
-    for(int i = 0; i < value.size(); i++) {
-        const auto ch = value[i];
-
-        switch(ch) {
-            case '\'': {
-                sql_stream << "\'\'";
-                break;
-            }
-
-            case '\\': {
-                // Доп обработка для json формата
-                if(i + 1 < value.size() && value[i + 1] == '"') {
-                    sql_stream << ch;
-                } else {
-                    sql_stream << "\\\\";
-                }
-
-                break;
-            }
-
-            default: {
-                sql_stream << ch;
-            }
-        }
-    }
-
-    if(value != query_craft::column_info::null_value()) {
-        sql_stream << "'";
-    }
-}
-} // namespace
+#include <cmath>
+#include <locale>
+#include <random>
+#include <sstream>
+#include <unordered_set>
+#include <utility>
 
 namespace query_craft {
 
@@ -60,222 +30,394 @@ sql_table::sql_table(table&& other)
 
 sql_table& sql_table::add_row(const row& row)
 {
-    if(row.empty())
-        throw std::logic_error("Ошибка. Попытка добавить пустую строку");
-
-    if(!rows.empty() && rows.begin()->size() != row.size())
-        throw std::logic_error("Ошибка. Не совпадает размер строки с уже добавленными в таблицу");
+    check_row(row);
 
     rows.push_back(row);
     return *this;
 }
 
-std::string sql_table::insert_args(const std::initializer_list<column_info>& columns, const bool need_returning, const std::initializer_list<column_info>& returning_columns)
+sql_table& sql_table::add_row(row&& row)
 {
-    return insert_sql(std::vector<column_info>(columns), need_returning, std::vector<column_info>(returning_columns));
+    check_row(row);
+
+    rows.push_back(std::move(row));
+    return *this;
 }
 
-std::string sql_table::insert_sql(const std::vector<column_info>& columns, bool need_returning, const std::vector<column_info>& returning_columns)
+std::string sql_table::insert_args(array_view<column_info> columns, const bool need_returning, array_view<column_info> returning_columns)
 {
-    const auto insert_columns = columns.empty() ? _columns : columns;
-
-    if(insert_columns.empty())
-        throw std::invalid_argument("Ошибка. Отсутствует информация о колонках");
-
-    if(rows.empty())
-        throw std::invalid_argument("Ошибка. Отсутвуют строки для всатвки");
-
-    if(rows.front().size() != insert_columns.size())
-        throw std::invalid_argument("Ошибка. Не совпадает колличество колонок с размером данных");
-
-    std::stringstream sql_stream;
-    sql_stream << "INSERT INTO " << table_name() << " (";
-
-    for(const auto& column : insert_columns) {
-        sql_stream << "\"" << column.name() << "\""
-                   << ", ";
-    }
-
-    sql_stream.seekp(-2, std::stringstream::cur);
+    return insert_sql(columns, need_returning, returning_columns);
+}
 
-    sql_stream << ") VALUES";
+std::string sql_table::insert_sql(array_view<column_info> columns, bool need_returning, array_view<column_info> returning_columns)
+{
+    auto sql = helper::insert_sql(*this, rows, columns, need_returning, returning_columns);
 
-    for(const auto& row : rows) {
-        sql_stream << " (";
+    rows.clear();
 
-        for(const auto& value : row) {
-            insert_with_escaping_character(sql_stream, value);
-            sql_stream << ", ";
-        }
+    return sql;
+}
 
-        sql_stream.seekp(-2, std::stringstream::cur);
+void sql_table::insert_sql(std::string& out, array_view<column_info> columns, const bool need_returning, array_view<column_info> returning_columns)
+{
+    helper::insert_sql(out, *this, rows, columns, need_returning, returning_columns);
 
-        sql_stream << "),";
-    }
+    rows.clear();
+}
 
-    sql_stream.seekp(-1, std::stringstream::cur);
+std::string sql_table::update_args_sql(const condition_group& condition, array_view<column_info> columns)
+{
+    return update_sql(condition, columns);
+}
 
-    if(need_returning) {
-        sql_stream << " RETURNING ";
+std::string sql_table::update_sql(const condition_group& condition, array_view<column_info> columns)
+{
+    auto sql = helper::update_sql(*this, rows, condition, columns);
 
-        if(returning_columns.empty()) {
-            sql_stream << "*";
-        } else {
-            for(const auto& returning_column : returning_columns) {
-                sql_stream << "\"" << returning_column.name() << "\""
-                           << ", ";
-            }
+    rows.clear();
 
-            sql_stream.seekp(-2, std::stringstream::cur);
-        }
-    }
+    return sql;
+}
 
-    sql_stream << ";";
+void sql_table::update_sql(std::string& out, const condition_group& condition, array_view<column_info> columns)
+{
+    helper::update_sql(out, *this, rows, condition, columns);
 
     rows.clear();
+}
 
-    return sql_stream.str();
+std::string sql_table::diff_update_sql(const row& old_row,
+    const row& new_row,
+    const condition_group& condition,
+    const bool distinct_guard,
+    array_view<column_info> columns) const
+{
+    return masked_update_sql(new_row, helper::changed_columns(old_row, new_row), condition, distinct_guard, columns);
 }
 
-std::string sql_table::update_args_sql(const condition_group& condition, const std::initializer_list<column_info>& columns)
+std::string sql_table::masked_update_sql(const row& new_row,
+    const std::vector<bool>& changed,
+    const condition_group& condition,
+    const bool distinct_guard,
+    array_view<column_info> columns) const
 {
-    return update_sql(condition, std::vector<column_info>(columns));
+    std::string sql;
+    helper::masked_update_sql(sql, *this, new_row, changed, condition, distinct_guard, columns);
+
+    return sql;
 }
 
-std::string sql_table::update_sql(const condition_group& condition, const std::vector<column_info>& columns)
+std::vector<std::string> sql_table::diff_update_batch_sql(const std::vector<std::pair<row, row>>& changes,
+    const column_info& key,
+    const bool distinct_guard,
+    array_view<column_info> columns) const
 {
-    const auto update_columns = columns.empty() ? _columns : columns;
+    return helper::diff_update_sql(*this, changes, key, distinct_guard, columns);
+}
 
-    if(update_columns.empty())
-        throw std::invalid_argument("Ошибка. Отсутствует информация о колонках");
+std::string sql_table::insert_from_select_sql(
+    array_view<column_info> target_columns,
+    const table& source,
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    const size_t limit,
+    const size_t offset,
+    array_view<column_info> source_columns) const
+{
+    std::string sql;
+    helper::insert_from_select_sql(sql, *this, target_columns, source, join_columns, condition, sort_columns, limit, offset, source_columns);
 
-    if(rows.empty())
-        throw std::invalid_argument("Ошибка. Отсутвуют строки для всатвки");
+    return sql;
+}
 
-    if(rows.front().size() != update_columns.size())
-        throw std::invalid_argument("Ошибка. Не совпадает колличество колонок с размером данных");
+std::string sql_table::move_to_sql(const table& target,
+    const condition_group& condition,
+    array_view<column_info> columns,
+    array_view<column_info> target_columns,
+    const size_t batch_limit) const
+{
+    std::string sql;
+    helper::move_rows_sql(sql, *this, target, condition, columns, target_columns, batch_limit);
 
-    if(rows.size() != 1)
-        throw std::invalid_argument("Ошибка. В рамках запроса update можно обновить использовать только 1 строку");
+    return sql;
+}
 
-    std::stringstream sql_stream;
+std::string sql_table::remove_sql(const condition_group& condition) const
+{
+    std::string sql;
+    sql.reserve(12 + table_name().size() + helper::where_size(condition, condion_view_type::name) + 1);
+    remove_sql(sql, condition);
 
-    sql_stream << "UPDATE " << table_name() << " SET ";
+    return sql;
+}
 
-    const auto& row = rows.front();
-    for(int i = 0; i < update_columns.size(); i++) {
-        sql_stream << "\"" << update_columns[i].name() << "\""
-                   << " = ";
+void sql_table::remove_sql(std::string& out, const condition_group& condition) const
+{
+    out.append("DELETE FROM ").append(table_name());
 
-        insert_with_escaping_character(sql_stream, row[i]);
+    helper::append_where(out, condition, condion_view_type::name);
 
-        sql_stream << ", ";
-    }
+    out.append(";");
+}
 
-    sql_stream.seekp(-2, std::stringstream::cur);
+std::string sql_table::select_args_sql(
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    const size_t limit,
+    const size_t offset,
+    array_view<column_info> columns) const
+{
+    return select_sql(join_columns, condition, sort_columns, limit, offset, columns);
+}
 
-    if(condition.is_valid())
-        sql_stream << " WHERE " << condition.unwrap();
+std::string sql_table::select_sql(
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    const size_t limit,
+    const size_t offset,
+    array_view<column_info> columns) const
+{
+    const auto select_columns = columns.empty() ? array_view<column_info>(_columns) : columns;
 
-    sql_stream << ";";
+    std::string sql;
+    sql.reserve(7
+        + helper::select_list_size(select_columns)
+        + 6 + table_name().size()
+        + helper::joins_size(join_columns)
+        + helper::where_size(condition, condion_view_type::full_name)
+        + helper::order_by_size(sort_columns)
+        + helper::limit_offset_size(limit, offset)
+        + 1);
 
-    rows.clear();
+    select_sql(sql, join_columns, condition, sort_columns, limit, offset, columns);
 
-    return sql_stream.str();
+    return sql;
 }
 
-std::string sql_table::remove_sql(const condition_group& condition) const
+void sql_table::select_sql(
+    std::string& out,
+    array_view<join_column> join_columns,
+    const condition_group& condition,
+    array_view<sort_column> sort_columns,
+    const size_t limit,
+    const size_t offset,
+    array_view<column_info> columns) const
 {
-    std::stringstream sql_stream;
+    // TODO Добавить реализацию group by, having
 
-    sql_stream << "DELETE FROM " << table_name();
+    const auto select_columns = columns.empty() ? array_view<column_info>(_columns) : columns;
 
-    if(condition.is_valid())
-        sql_stream << " WHERE " << condition.unwrap();
+    out.append("SELECT ");
+    helper::append_select_list(out, select_columns);
 
-    sql_stream << ";";
+    append_from(out, join_columns, condition);
 
-    return sql_stream.str();
+    helper::append_order_by(out, sort_columns);
+    helper::append_limit_offset(out, limit, offset);
+
+    out.append(";");
 }
 
-std::string sql_table::select_args_sql(
-    const std::initializer_list<join_column>& join_columns,
+sub_query sql_table::sub_select(
+    array_view<join_column> join_columns,
     const condition_group& condition,
-    const std::initializer_list<sort_column>& sort_columns,
+    array_view<sort_column> sort_columns,
     const size_t limit,
     const size_t offset,
-    const std::initializer_list<column_info>& columns) const
+    array_view<column_info> columns) const
 {
-    return select_sql(
-        std::vector<join_column>(join_columns),
-        condition,
-        std::vector<sort_column>(sort_columns),
-        limit,
-        offset,
-        std::vector<column_info>(columns));
+    return sub_query(select_sql(join_columns, condition, sort_columns, limit, offset, columns));
 }
 
-std::string sql_table::select_sql(
-    const std::vector<join_column>& join_columns,
+std::string sql_table::sample_select_sql(
+    const table_sample& sample,
+    array_view<join_column> join_columns,
     const condition_group& condition,
-    const std::vector<sort_column>& sort_columns,
+    array_view<sort_column> sort_columns,
     const size_t limit,
     const size_t offset,
-    const std::vector<column_info>& columns) const
+    array_view<column_info> columns) const
 {
-    // TODO Добавить реализацию group by, having
+    const auto select_columns = columns.empty() ? array_view<column_info>(_columns) : columns;
+
+    std::string sql;
+
+    sql.append("SELECT ");
+    helper::append_select_list(sql, select_columns);
+
+    append_from(sql, join_columns, condition, &sample);
+
+    helper::append_order_by(sql, sort_columns);
+    helper::append_limit_offset(sql, limit, offset);
+
+    sql.append(";");
+
+    return sql;
+}
+
+std::string sql_table::random_keys_select_sql(
+    const column_info& key,
+    const int64_t min_key,
+    const int64_t max_key,
+    const size_t count,
+    const uint64_t seed,
+    const condition_group& condition,
+    array_view<column_info> columns,
+    const double oversampling) const
+{
+    if(min_key > max_key)
+        throw std::invalid_argument("Ошибка. Минимальное значение ключа больше максимального");
+
+    if(count == 0)
+        throw std::invalid_argument("Ошибка. Количество строк должно быть больше нуля");
 
-    const auto select_columns = columns.empty() ? _columns : columns;
+    if(oversampling < 1)
+        throw std::invalid_argument("Ошибка. Коэффициент запаса должен быть не меньше 1");
 
-    std::stringstream sql_stream;
+    const auto range_size = static_cast<uint64_t>(max_key) - static_cast<uint64_t>(min_key) + 1;
+    const auto key_count = static_cast<uint64_t>(std::ceil(static_cast<double>(count) * oversampling));
+
+    condition_group key_condition;
+
+    if(range_size != 0 && range_size <= count) {
+        // В диапазоне не больше count ключей, поэтому выбираются все строки диапазона
+        key_condition = key >= min_key && key <= max_key;
+
+        return select_sql({}, condition.is_valid() ? key_condition && condition : key_condition, {}, count, 0, columns);
+    }
 
-    sql_stream << "SELECT ";
+    std::mt19937_64 generator(seed);
 
-    if(!select_columns.empty()) {
-        for(const column_info& column : select_columns) {
-            sql_stream << column.full_name() << " AS " << column.alias() << ", ";
+    if(range_size != 0 && range_size <= key_count) {
+        // Диапазон меньше запаса ключей: случайные ключи без повторов выбираются частичным перемешиванием диапазона.
+        // Запас здесь не используется, так как LIMIT отбросил бы ключи не случайно, а в порядке чтения
+        std::vector<int64_t> range(static_cast<size_t>(range_size));
+        for(size_t i = 0; i < range.size(); i++)
+            range[i] = min_key + static_cast<int64_t>(i);
+
+        for(size_t i = 0; i < count; i++) {
+            std::uniform_int_distribution<size_t> distribution(i, range.size() - 1);
+            std::swap(range[i], range[distribution(generator)]);
         }
-        sql_stream.seekp(-2, std::stringstream::cur);
-    } else {
-        sql_stream << "*";
+
+        key_condition = key.in_list(range.begin(), range.begin() + static_cast<std::ptrdiff_t>(count));
+
+        return select_sql({}, condition.is_valid() ? key_condition && condition : key_condition, {}, count, 0, columns);
     }
 
-    sql_stream << " FROM " << table_name();
+    std::uniform_int_distribution<int64_t> distribution(min_key, max_key);
+
+    std::unordered_set<int64_t> keys;
+    keys.reserve(static_cast<size_t>(key_count));
+
+    while(keys.size() < key_count)
+        keys.insert(distribution(generator));
+
+    key_condition = key.in_list(keys.begin(), keys.end());
+
+    // Совпадения IN возвращаются в порядке чтения индекса, и LIMIT без сортировки оставил бы наименьшие ключи.
+    // Сортируются только найденные строки, которых не больше key_count
+    return select_sql({}, condition.is_valid() ? key_condition && condition : key_condition, { random_sort() }, count, 0, columns);
+}
+
+std::string sql_table::exists_sql(array_view<join_column> join_columns, const condition_group& condition) const
+{
+    std::string sql;
+    sql.append("SELECT EXISTS (SELECT 1");
+    append_from(sql, join_columns, condition);
+    sql.append(");");
 
-    for(const auto& joinColumn : join_columns) {
-        sql_stream << joinColumn << " ";
+    return sql;
+}
+
+std::string sql_table::count_sql(array_view<join_column> join_columns, const condition_group& condition) const
+{
+    std::string sql;
+    sql.append("SELECT COUNT(*)");
+    append_from(sql, join_columns, condition);
+    sql.append(";");
+
+    return sql;
+}
+
+std::string sql_table::estimated_count_sql(const condition_group& condition) const
+{
+    std::string sql;
+
+    if(!condition.is_valid()) {
+        // reltuples равен -1 для таблиц, по которым еще не собиралась статистика
+        sql.append("SELECT GREATEST(reltuples, 0)::bigint FROM pg_class WHERE oid = '")
+            .append(table_name())
+            .append("'::regclass;");
+
+        return sql;
     }
-    if(condition.is_valid())
-        sql_stream << " WHERE " << condition.unwrap(condion_view_type::full_name);
-
-    if(!sort_columns.empty()) {
-        sql_stream << " ORDER BY ";
-
-        for(const auto& sortColumn : sort_columns) {
-            sql_stream << sortColumn.column.alias();
-
-            switch(sortColumn.sort_type) {
-                case sort_column::type::asc:
-                    sql_stream << " ASC, ";
-                    break;
-                case sort_column::type::desc:
-                    sql_stream << " DESC, ";
-                    break;
-            }
-        }
 
-        sql_stream.seekp(-2, std::stringstream::cur);
+    sql.append("EXPLAIN (FORMAT JSON) SELECT 1");
+    append_from(sql, {}, condition);
+    sql.append(";");
+
+    return sql;
+}
+
+size_t sql_table::parse_estimated_count(const std::string& explain_json)
+{
+    static const std::string plan_rows_key = "\"Plan Rows\":";
+
+    auto position = explain_json.find(plan_rows_key);
+    if(position == std::string::npos)
+        throw std::invalid_argument("Ошибка. В результате EXPLAIN отсутствует оценка количества строк");
+
+    position += plan_rows_key.size();
+    while(position < explain_json.size() && explain_json[position] == ' ')
+        position++;
+
+    size_t count = 0;
+    auto has_digits = false;
+
+    while(position < explain_json.size() && explain_json[position] >= '0' && explain_json[position] <= '9') {
+        count = count * 10 + static_cast<size_t>(explain_json[position] - '0');
+        has_digits = true;
+        position++;
     }
 
-    if(limit != 0)
-        sql_stream << " LIMIT " << limit;
+    if(!has_digits)
+        throw std::invalid_argument("Ошибка. Некорректная оценка количества строк в результате EXPLAIN");
 
-    if(offset != 0)
-        sql_stream << " OFFSET " << offset;
+    return count;
+}
 
-    sql_stream << ";";
+void sql_table::check_row(const row& row) const
+{
+    if(row.empty())
+        throw std::logic_error("Ошибка. Попытка добавить пустую строку");
+
+    if(!rows.empty() && rows.begin()->size() != row.size())
+        throw std::logic_error("Ошибка. Не совпадает размер строки с уже добавленными в таблицу");
+}
+
+void sql_table::append_from(std::string& out, array_view<join_column> join_columns, const condition_group& condition, const table_sample* sample) const
+{
+    out.append(" FROM ").append(table_name());
+
+    if(sample != nullptr) {
+        std::ostringstream percent;
+        percent.imbue(std::locale::classic());
+        percent << sample->percent;
+
+        out.append(sample->sample_method == table_sample::method::system ? " TABLESAMPLE SYSTEM (" : " TABLESAMPLE BERNOULLI (")
+            .append(percent.str())
+            .append(")");
+
+        if(sample->repeatable)
+            out.append(" REPEATABLE (").append(std::to_string(sample->seed)).append(")");
+    }
 
-    return sql_stream.str();
+    helper::append_joins(out, join_columns);
+    helper::append_where(out, condition, condion_view_type::full_name);
 }
 
 } // namespace query_craft
\ No newline at end of file
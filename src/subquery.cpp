@@ -0,0 +1,22 @@
+#include "QueryCraft/subquery.h"
+
+namespace query_craft {
+
+sub_query::sub_query(std::string sql)
+    : _sql(std::move(sql))
+{
+    while(!_sql.empty() && (_sql.back() == ';' || _sql.back() == ' '))
+        _sql.pop_back();
+}
+
+const std::string& sub_query::sql() const
+{
+    return _sql;
+}
+
+bool sub_query::is_valid() const
+{
+    return !_sql.empty();
+}
+
+} // namespace query_craft
\ No newline at end of file
@@ -14,12 +14,11 @@ table& table::add_column(column_info& column)
         alias_stream << _scheme << "_";
 
     alias_stream << _table_name << "_" << column.name();
-    column.set_alias(alias_stream.str());
 
     std::stringstream full_name_stream;
     full_name_stream << table_name() << "."
                      << "\"" << column.name() << "\"";
-    column.set_full_name(full_name_stream.str());
+    column.set_names(full_name_stream.str(), alias_stream.str());
 
     if(_columns_map.find(column.name()) != _columns_map.end())
         throw std::logic_error("Ошибка. Дублируется название колонки");
@@ -30,17 +29,32 @@ table& table::add_column(column_info& column)
     return *this;
 }
 
-std::string table::table_name() const
+const std::string& table::table_name() const
 {
-    std::stringstream table_name_stream;
+    return _full_table_name;
+}
 
-    if(!_scheme.empty())
-        table_name_stream << "\"" << _scheme << "\""
-                          << ".";
+const std::string& table::name() const
+{
+    return _table_name;
+}
+
+const std::string& table::scheme() const
+{
+    return _scheme;
+}
+
+std::string table::make_full_table_name(const std::string& scheme, const std::string& table_name)
+{
+    std::string full_name;
+
+    if(!scheme.empty()) {
+        full_name.append("\"").append(scheme).append("\".");
+    }
 
-    table_name_stream << "\"" << _table_name << "\"";
+    full_name.append("\"").append(table_name).append("\"");
 
-    return table_name_stream.str();
+    return full_name;
 }
 
 column_info table::column(const std::string& name) const
@@ -59,7 +73,7 @@ column_info table::column(const int index) const
     return _columns[index];
 }
 
-std::vector<column_info> table::columns() const
+const std::vector<column_info>& table::columns() const
 {
     return _columns;
 }
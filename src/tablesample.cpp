@@ -0,0 +1,41 @@
+#include "QueryCraft/tablesample.h"
+
+#include <stdexcept>
+
+namespace {
+
+query_craft::table_sample make_sample(const query_craft::table_sample::method method, const double percent)
+{
+    if(!(percent >= 0 && percent <= 100))
+        throw std::invalid_argument("Ошибка. Доля выборки должна быть в диапазоне от 0 до 100");
+
+    query_craft::table_sample sample;
+    sample.sample_method = method;
+    sample.percent = percent;
+
+    return sample;
+}
+
+} // namespace
+
+namespace query_craft {
+
+table_sample system_sample(const double percent)
+{
+    return make_sample(table_sample::method::system, percent);
+}
+
+table_sample bernoulli_sample(const double percent)
+{
+    return make_sample(table_sample::method::bernoulli, percent);
+}
+
+table_sample repeatable(table_sample sample, const int64_t seed)
+{
+    sample.repeatable = true;
+    sample.seed = seed;
+
+    return sample;
+}
+
+} // namespace query_craft
\ No newline at end of file